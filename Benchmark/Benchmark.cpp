@@ -0,0 +1,1167 @@
+#include "Delegate.h"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Delegates of this signature record per subscriber latency, so the
+// instrumentation suite can measure what that costs.
+template <>
+struct DelegateInstrumentation< void( long ) >
+{
+	using Type = LatencyInstrumentation;
+};
+
+// Delegates of this signature keep their storage in the shared pool, for
+// the allocation suite.
+template <>
+struct DelegateAllocator< void( short ) >
+{
+	template < typename T >
+	using Type = DelegatePoolAllocator< T >;
+};
+
+// Counts global heap allocations, so suites can report them per operation.
+// The whole replaceable family is defined, so every new is paired with
+// the matching delete.
+static atomic< size_t > s_HeapAllocations( 0 );
+
+static void* CountedAllocate( size_t a_Size )
+{
+	s_HeapAllocations.fetch_add( 1, memory_order_relaxed );
+
+	if ( void* Result = malloc( a_Size ? a_Size : 1 ) )
+	{
+		return Result;
+	}
+
+	throw bad_alloc();
+}
+
+static void* CountedAllocate( size_t a_Size, align_val_t a_Alignment )
+{
+	s_HeapAllocations.fetch_add( 1, memory_order_relaxed );
+
+	// aligned_alloc wants the size to be a multiple of the alignment.
+	const size_t Alignment = static_cast< size_t >( a_Alignment );
+	const size_t Size = ( ( a_Size ? a_Size : 1 ) + Alignment - 1 ) & ~( Alignment - 1 );
+
+	if ( void* Result = aligned_alloc( Alignment, Size ) )
+	{
+		return Result;
+	}
+
+	throw bad_alloc();
+}
+
+void* operator new( size_t a_Size ) { return CountedAllocate( a_Size ); }
+void* operator new[]( size_t a_Size ) { return CountedAllocate( a_Size ); }
+void* operator new( size_t a_Size, align_val_t a_Alignment ) { return CountedAllocate( a_Size, a_Alignment ); }
+void* operator new[]( size_t a_Size, align_val_t a_Alignment ) { return CountedAllocate( a_Size, a_Alignment ); }
+
+void operator delete( void* a_Pointer ) noexcept { free( a_Pointer ); }
+void operator delete[]( void* a_Pointer ) noexcept { free( a_Pointer ); }
+void operator delete( void* a_Pointer, size_t ) noexcept { free( a_Pointer ); }
+void operator delete[]( void* a_Pointer, size_t ) noexcept { free( a_Pointer ); }
+void operator delete( void* a_Pointer, align_val_t ) noexcept { free( a_Pointer ); }
+void operator delete[]( void* a_Pointer, align_val_t ) noexcept { free( a_Pointer ); }
+void operator delete( void* a_Pointer, size_t, align_val_t ) noexcept { free( a_Pointer ); }
+void operator delete[]( void* a_Pointer, size_t, align_val_t ) noexcept { free( a_Pointer ); }
+
+//==========================================================================
+// Benchmarks
+//==========================================================================
+namespace Benchmark
+{
+	static uint64_t s_Sink = 0;
+
+	/// <summary>
+	/// Hides a value from the optimizer, so it can neither be treated as a
+	/// constant nor have its uses removed.
+	/// </summary>
+	template < typename T >
+	inline void Escape( T& a_Value )
+	{
+#if defined( __GNUC__ )
+		asm volatile( "" : : "g"( &a_Value ) : "memory" );
+#else
+		static void* volatile s_Escaped;
+		s_Escaped = static_cast< void* >( &a_Value );
+#endif
+	}
+
+	template < int N >
+	void StaticTick( int a_Value )
+	{
+		s_Sink += a_Value + N;
+	}
+
+	template < int N >
+	struct MemberTick
+	{
+		void Tick( int a_Value )
+		{
+			s_Sink += a_Value * N;
+		}
+	};
+
+	/// <summary>
+	/// Counts mispredicted branches of the calling thread through
+	/// perf_event_open. Reports nothing where that is unavailable.
+	/// </summary>
+	class BranchMissCounter
+	{
+	public:
+
+#ifdef __linux__
+		BranchMissCounter()
+		{
+			perf_event_attr Attributes = { };
+			Attributes.type = PERF_TYPE_HARDWARE;
+			Attributes.size = sizeof( Attributes );
+			Attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+			Attributes.disabled = 1;
+			Attributes.exclude_kernel = 1;
+			Attributes.exclude_hv = 1;
+			m_Descriptor = static_cast< int >( syscall( __NR_perf_event_open, &Attributes, 0, -1, -1, 0 ) );
+		}
+
+		~BranchMissCounter()
+		{
+			if ( IsAvailable() )
+			{
+				close( m_Descriptor );
+			}
+		}
+
+		inline bool IsAvailable() const { return m_Descriptor >= 0; }
+
+		inline void Start()
+		{
+			if ( IsAvailable() )
+			{
+				ioctl( m_Descriptor, PERF_EVENT_IOC_RESET, 0 );
+				ioctl( m_Descriptor, PERF_EVENT_IOC_ENABLE, 0 );
+			}
+		}
+
+		inline uint64_t Stop()
+		{
+			uint64_t Count = 0;
+
+			if ( IsAvailable() )
+			{
+				ioctl( m_Descriptor, PERF_EVENT_IOC_DISABLE, 0 );
+
+				if ( read( m_Descriptor, &Count, sizeof( Count ) ) != sizeof( Count ) )
+				{
+					Count = 0;
+				}
+			}
+
+			return Count;
+		}
+
+	private:
+
+		int m_Descriptor;
+#else
+		inline bool IsAvailable() const { return false; }
+		inline void Start() { }
+		inline uint64_t Stop() { return 0; }
+#endif
+
+	};
+
+	//==========================================================================
+	// Collects results, echoes them to the console and writes them as JSON
+	// for tracking regressions between runs.
+	//==========================================================================
+	class Report
+	{
+	public:
+
+		void Add( const string& a_Suite, const string& a_Name, size_t a_Size, double a_Value, const char* a_Unit )
+		{
+			m_Results.push_back( { a_Suite, a_Name, a_Size, a_Value, a_Unit } );
+			cout << a_Suite << " / " << a_Name << " [" << a_Size << "]: " << a_Value << " " << a_Unit << endl;
+		}
+
+		void Write( ostream& a_Stream ) const
+		{
+			a_Stream << "{\n  \"context\": {\n";
+			a_Stream << "    \"compiler\": \"" << GetCompiler() << "\",\n";
+#ifdef NDEBUG
+			a_Stream << "    \"build\": \"release\",\n";
+#else
+			a_Stream << "    \"build\": \"debug\",\n";
+#endif
+			a_Stream << "    \"pointer_size\": " << sizeof( void* ) << ",\n";
+			a_Stream << "    \"invoker_buffer_size\": " << INVOKER_BUFFER_SIZE << "\n  },\n";
+			a_Stream << "  \"results\": [\n";
+
+			for ( size_t i = 0; i < m_Results.size(); ++i )
+			{
+				const Result& Current = m_Results[ i ];
+				a_Stream << "    { \"suite\": \"" << Escaped( Current.Suite )
+						 << "\", \"name\": \"" << Escaped( Current.Name )
+						 << "\", \"size\": " << Current.Size
+						 << ", \"value\": " << Current.Value
+						 << ", \"unit\": \"" << Current.Unit << "\" }"
+						 << ( i + 1 < m_Results.size() ? ",\n" : "\n" );
+			}
+
+			a_Stream << "  ]\n}\n";
+		}
+
+	private:
+
+		struct Result
+		{
+			string      Suite;
+			string      Name;
+			size_t      Size;
+			double      Value;
+			const char* Unit;
+		};
+
+		static string Escaped( const string& a_Text )
+		{
+			string Result;
+
+			for ( char Character : a_Text )
+			{
+				if ( Character == '"' || Character == '\\' )
+				{
+					Result += '\\';
+				}
+
+				Result += Character;
+			}
+
+			return Result;
+		}
+
+		static const char* GetCompiler()
+		{
+#if defined( __clang__ )
+			return "clang " __clang_version__;
+#elif defined( __GNUC__ )
+			return "gcc " __VERSION__;
+#elif defined( _MSC_VER )
+			return "msvc";
+#else
+			return "unknown";
+#endif
+		}
+
+		vector< Result > m_Results;
+
+	};
+
+	/// <summary>
+	/// Runs a_Body once to warm up, then a_Repetitions times and returns
+	/// the fastest run in nanoseconds per operation.
+	/// </summary>
+	template < typename Body >
+	double Measure( size_t a_Operations, Body&& a_Body, size_t a_Repetitions = 5 )
+	{
+		a_Body();
+		double Best = numeric_limits< double >::max();
+
+		for ( size_t i = 0; i < a_Repetitions; ++i )
+		{
+			const auto Start = chrono::steady_clock::now();
+			a_Body();
+			const chrono::duration< double, nano > Elapsed = chrono::steady_clock::now() - Start;
+			Best = Elapsed.count() < Best ? Elapsed.count() : Best;
+		}
+
+		return Best / static_cast< double >( a_Operations );
+	}
+
+	//==========================================================================
+	// Call targets for the call overhead suite.
+	//==========================================================================
+	struct Target
+	{
+		virtual ~Target() { }
+		virtual int Virtual( int a_Value ) = 0;
+	};
+
+	struct CountingTarget : Target
+	{
+		int Member( int a_Value )
+		{
+			return a_Value + m_State;
+		}
+
+		int Virtual( int a_Value ) override
+		{
+			return a_Value + m_State;
+		}
+
+		int m_State = 1;
+	};
+
+	struct OtherTarget : Target
+	{
+		int Virtual( int a_Value ) override
+		{
+			return a_Value - 1;
+		}
+	};
+
+	int StaticTarget( int a_Value )
+	{
+		return a_Value + 1;
+	}
+
+	/// <summary>
+	/// Calls a_Callable a_Calls times with a varying argument.
+	/// </summary>
+	template < typename Callable >
+	double MeasureCalls( size_t a_Calls, Callable& a_Callable )
+	{
+		Escape( a_Callable );
+
+		return Measure( a_Calls, [ & ]()
+		{
+			int Sum = 0;
+
+			for ( size_t i = 0; i < a_Calls; ++i )
+			{
+				Sum += a_Callable( static_cast< int >( i ) );
+			}
+
+			s_Sink += Sum;
+		} );
+	}
+
+	/// <summary>
+	/// Single target call cost of Invoker against a raw function pointer, a
+	/// virtual call and std::function, for static, member and lambda
+	/// targets.
+	/// </summary>
+	void CallOverhead( Report& a_Report, size_t a_Calls )
+	{
+		CountingTarget Object;
+		OtherTarget Other;
+		Target* Virtual = s_Sink == ~uint64_t( 0 ) ? static_cast< Target* >( &Other ) : &Object;
+		Escape( Virtual );
+
+		{
+			int ( *Raw )( int ) = StaticTarget;
+			auto RawCall = [ & ]( int a_Value ) { return Raw( a_Value ); };
+			function< int( int ) > Function( StaticTarget );
+			Invoker< int, int > Callable( StaticTarget );
+
+			Escape( Raw );
+			a_Report.Add( "call", "static/raw pointer", 1, MeasureCalls( a_Calls, RawCall ), "ns/call" );
+			a_Report.Add( "call", "static/std::function", 1, MeasureCalls( a_Calls, Function ), "ns/call" );
+			a_Report.Add( "call", "static/Invoker", 1, MeasureCalls( a_Calls, Callable ), "ns/call" );
+		}
+
+		{
+			int ( CountingTarget::*Raw )( int ) = &CountingTarget::Member;
+			auto RawCall = [ & ]( int a_Value ) { return ( Object.*Raw )( a_Value ); };
+			auto VirtualCall = [ & ]( int a_Value ) { return Virtual->Virtual( a_Value ); };
+			function< int( int ) > Function( [ & ]( int a_Value ) { return Object.Member( a_Value ); } );
+			Invoker< int, int > Callable( Object, &CountingTarget::Member );
+
+			Escape( Raw );
+			a_Report.Add( "call", "member/raw pointer", 1, MeasureCalls( a_Calls, RawCall ), "ns/call" );
+			a_Report.Add( "call", "member/virtual", 1, MeasureCalls( a_Calls, VirtualCall ), "ns/call" );
+			a_Report.Add( "call", "member/std::function", 1, MeasureCalls( a_Calls, Function ), "ns/call" );
+			a_Report.Add( "call", "member/Invoker", 1, MeasureCalls( a_Calls, Callable ), "ns/call" );
+
+#ifdef __cpp_nontype_template_parameter_auto
+			auto Bound = Invoker< int, int >::Bind< &CountingTarget::Member >( Object );
+			a_Report.Add( "call", "member/Invoker::Bind", 1, MeasureCalls( a_Calls, Bound ), "ns/call" );
+#endif
+		}
+
+		{
+			int State = 1;
+			auto Lambda = [ &State ]( int a_Value ) { return a_Value + State; };
+			function< int( int ) > Function( Lambda );
+			Invoker< int, int > Callable( Lambda );
+
+			a_Report.Add( "call", "lambda/std::function", 1, MeasureCalls( a_Calls, Function ), "ns/call" );
+			a_Report.Add( "call", "lambda/Invoker", 1, MeasureCalls( a_Calls, Callable ), "ns/call" );
+		}
+	}
+
+	/// <summary>
+	/// Broadcast cost per subscriber call from 1 to 100k subscribers.
+	/// </summary>
+	void InvokeAllScaling( Report& a_Report, size_t a_Calls )
+	{
+		MemberTick< 1 > Member;
+
+		for ( size_t Subscribers = 1; Subscribers <= 100000; Subscribers *= 10 )
+		{
+			Delegate< void, int > Subject;
+
+			for ( size_t i = 0; i < Subscribers; ++i )
+			{
+				Subject.Add( Member, &MemberTick< 1 >::Tick );
+			}
+
+			const size_t Broadcasts = a_Calls / Subscribers ? a_Calls / Subscribers : 1;
+
+			const double PerCall = Measure( Broadcasts * Subscribers, [ & ]()
+			{
+				for ( size_t i = 0; i < Broadcasts; ++i )
+				{
+					Subject.InvokeAll( static_cast< int >( i ) );
+				}
+			} );
+
+			a_Report.Add( "invoke_all", "member", Subscribers, PerCall, "ns/call" );
+		}
+	}
+
+	/// <summary>
+	/// The same broadcast with and without LatencyInstrumentation.
+	/// </summary>
+	void Instrumentation( Report& a_Report, size_t a_Calls, size_t a_Subscribers = 1000 )
+	{
+		Delegate< void, int > Plain;
+		Delegate< void, long > Instrumented;
+
+		for ( size_t i = 0; i < a_Subscribers; ++i )
+		{
+			Plain.Add( []( int a_Value ) { s_Sink += a_Value; } );
+			Instrumented.Add( []( long a_Value ) { s_Sink += a_Value; } );
+		}
+
+		const size_t Broadcasts = a_Calls / a_Subscribers ? a_Calls / a_Subscribers : 1;
+
+		a_Report.Add( "instrumentation", "off", a_Subscribers, Measure( Broadcasts * a_Subscribers, [ & ]()
+		{
+			for ( size_t i = 0; i < Broadcasts; ++i )
+			{
+				Plain.InvokeAll( static_cast< int >( i ) );
+			}
+		} ), "ns/call" );
+
+		a_Report.Add( "instrumentation", "latency", a_Subscribers, Measure( Broadcasts * a_Subscribers, [ & ]()
+		{
+			for ( size_t i = 0; i < Broadcasts; ++i )
+			{
+				Instrumented.InvokeAll( static_cast< long >( i ) );
+			}
+		} ), "ns/call" );
+	}
+
+	/// <summary>
+	/// A subscriber at the front replaces a_Churn random subscribers during
+	/// every broadcast, exercising deferred removal and appending while
+	/// invoking. Reported next to the same delegate without churn.
+	/// </summary>
+	void Churn( Report& a_Report, size_t a_Calls, size_t a_Churn = 4 )
+	{
+		for ( size_t Subscribers = 100; Subscribers <= 10000; Subscribers *= 10 )
+		{
+			Delegate< void, int > Subject;
+			vector< DelegateHandle > Handles;
+			mt19937 Random( 42 );
+			bool IsChurning = false;
+			auto Plain = []( int a_Value ) { s_Sink += a_Value; };
+
+			Subject.Add( [ & ]( int )
+			{
+				for ( size_t i = 0; IsChurning && i < a_Churn; ++i )
+				{
+					DelegateHandle& Victim = Handles[ Random() % Handles.size() ];
+					Subject.Remove( Victim );
+					Victim = Subject.Add( Plain );
+				}
+			} );
+
+			for ( size_t i = 0; i < Subscribers; ++i )
+			{
+				Handles.push_back( Subject.Add( Plain ) );
+			}
+
+			const size_t Broadcasts = a_Calls / Subscribers ? a_Calls / Subscribers : 1;
+
+			auto Run = [ & ]()
+			{
+				for ( size_t i = 0; i < Broadcasts; ++i )
+				{
+					Subject.InvokeAll( static_cast< int >( i ) );
+				}
+			};
+
+			a_Report.Add( "churn", "steady", Subscribers, Measure( Broadcasts, Run ), "ns/broadcast" );
+			IsChurning = true;
+			a_Report.Add( "churn", "replace 4 per broadcast", Subscribers, Measure( Broadcasts, Run ), "ns/broadcast" );
+		}
+	}
+
+	/// <summary>
+	/// An entity holding a_Matches subscriptions among unrelated ones drops
+	/// them all with RemoveAll( Object* ) and subscribes again. The cost
+	/// should follow a_Matches, not the size of the delegate.
+	/// </summary>
+	void BulkRemoval( Report& a_Report, size_t a_Calls, size_t a_Matches = 16 )
+	{
+		for ( size_t Subscribers = 100; Subscribers <= 100000; Subscribers *= 10 )
+		{
+			Delegate< void, int > Subject;
+			vector< MemberTick< 1 > > Others( Subscribers );
+			MemberTick< 1 > Entity;
+
+			for ( MemberTick< 1 >& Other : Others )
+			{
+				Subject.Add( Other, &MemberTick< 1 >::Tick );
+			}
+
+			const size_t Rounds = a_Calls / 100 ? a_Calls / 100 : 1;
+
+			const double PerRemoval = Measure( Rounds, [ & ]()
+			{
+				for ( size_t i = 0; i < Rounds; ++i )
+				{
+					for ( size_t j = 0; j < a_Matches; ++j )
+					{
+						Subject.Add( Entity, &MemberTick< 1 >::Tick );
+					}
+
+					Subject.RemoveAll( &Entity );
+				}
+			} );
+
+			a_Report.Add( "bulk removal", "Add x16+RemoveAll(Object*)", Subscribers, PerRemoval, "ns/op" );
+		}
+	}
+
+	template < typename Arg >
+	struct Subscriber
+	{
+		void Tick( Arg a_Value )
+		{
+			s_Sink += a_Value;
+		}
+	};
+
+	/// <summary>
+	/// Steady state subscription churn: subscribers bound to rotating
+	/// objects and lambdas with out of line captures are removed and added
+	/// again. Run with the default allocator and with DelegatePoolAllocator,
+	/// reporting time and global heap allocations per replacement.
+	/// </summary>
+	template < typename Arg >
+	void AllocationChurn( Report& a_Report, const char* a_Name, size_t a_Calls, size_t a_Subscribers = 1000 )
+	{
+		Delegate< void, Arg > Subject;
+		vector< Subscriber< Arg > > Objects( a_Subscribers );
+		vector< DelegateHandle > Handles;
+		const array< uint64_t, 8 > Capture = { };
+		auto Lambda = [ Capture ]( Arg a_Value ) { s_Sink += Capture[ 0 ] + a_Value; };
+
+		for ( size_t i = 0; i < a_Subscribers; ++i )
+		{
+			Handles.push_back( Subject.Add( Objects[ i ], &Subscriber< Arg >::Tick ) );
+		}
+
+		const size_t Replacements = a_Calls / 10 ? a_Calls / 10 : 1;
+		size_t Round = 0;
+
+		auto Run = [ & ]()
+		{
+			for ( size_t i = 0; i < Replacements; ++i )
+			{
+				const size_t Index = i % a_Subscribers;
+				Subject.Remove( Handles[ Index ] );
+				Handles[ Index ] = Index & 1 ? Subject.Add( Lambda ) : Subject.Add( Objects[ ( Index + ++Round ) % a_Subscribers ], &Subscriber< Arg >::Tick );
+			}
+		};
+
+		Run();
+		const size_t Before = s_HeapAllocations.load();
+		const double PerReplacement = Measure( Replacements, Run );
+		const double Allocations = static_cast< double >( s_HeapAllocations.load() - Before ) / static_cast< double >( Replacements * 6 );
+
+		a_Report.Add( "allocation", string( a_Name ) + " Remove+Add", a_Subscribers, PerReplacement, "ns/op" );
+		a_Report.Add( "allocation", string( a_Name ) + " heap allocations", a_Subscribers, Allocations, "allocations/op" );
+	}
+
+	/// <summary>
+	/// Invoke( size_t ) at random indices, and Insert( size_t ) or a
+	/// prioritised Add near the front paired with removing the inserted
+	/// subscriber again so the size stays put.
+	/// </summary>
+	void IndexedAccess( Report& a_Report, size_t a_Calls )
+	{
+		for ( size_t Subscribers = 10; Subscribers <= 100000; Subscribers *= 10 )
+		{
+			Delegate< void, int > Subject;
+
+			for ( size_t i = 0; i < Subscribers; ++i )
+			{
+				Subject.Add( StaticTick< 0 > );
+			}
+
+			vector< size_t > Indices( 4096 );
+			mt19937 Random( 42 );
+
+			for ( size_t& Index : Indices )
+			{
+				Index = Random() % Subscribers;
+			}
+
+			const double PerInvoke = Measure( a_Calls, [ & ]()
+			{
+				for ( size_t i = 0; i < a_Calls; ++i )
+				{
+					Subject.Invoke( Indices[ i & ( Indices.size() - 1 ) ], static_cast< int >( i ) );
+				}
+			} );
+
+			a_Report.Add( "indexed", "Invoke(size_t)", Subscribers, PerInvoke, "ns/call" );
+
+			const size_t Inserts = a_Calls / Subscribers / 10 ? a_Calls / Subscribers / 10 : 10;
+			const size_t Middle = Subscribers / 2;
+
+			const double PerInsert = Measure( Inserts, [ & ]()
+			{
+				for ( size_t i = 0; i < Inserts; ++i )
+				{
+					Subject.Insert( Middle, StaticTick< 1 > );
+					Subject.Remove( Middle );
+				}
+			} );
+
+			a_Report.Add( "indexed", "Insert(size_t)+Remove", Subscribers, PerInsert, "ns/op" );
+
+			const DelegateHandle Anchor = Subject.Add( 1, StaticTick< 2 > );
+
+			const double PerPriority = Measure( Inserts, [ & ]()
+			{
+				for ( size_t i = 0; i < Inserts; ++i )
+				{
+					Subject.Remove( Subject.Add( 1, StaticTick< 1 > ) );
+				}
+			} );
+
+			Subject.Remove( Anchor );
+			a_Report.Add( "indexed", "Add(priority)+Remove", Subscribers, PerPriority, "ns/op" );
+		}
+	}
+
+	struct MoveEvent { int Distance; };
+	struct HitEvent { int Damage; };
+	struct SpawnEvent { int Count; };
+
+	/// <summary>
+	/// Publishing to one subscriber through an EventBus against the string
+	/// keyed map of delegates it replaces.
+	/// </summary>
+	void EventBusPublish( Report& a_Report, size_t a_Calls )
+	{
+		EventBus< MoveEvent, HitEvent, SpawnEvent > Bus;
+		unordered_map< string, Delegate< void, const HitEvent& > > ByName;
+		auto Handler = []( const HitEvent& a_Event ) { s_Sink += a_Event.Damage; };
+		const string Name = "HitEvent";
+
+		Bus.Subscribe< HitEvent >( Handler );
+		ByName[ "MoveEvent" ];
+		ByName[ Name ].Add( Handler );
+		ByName[ "SpawnEvent" ];
+
+		a_Report.Add( "event bus", "EventBus::Publish", 1, Measure( a_Calls, [ & ]()
+		{
+			for ( size_t i = 0; i < a_Calls; ++i )
+			{
+				Bus.Publish( HitEvent{ static_cast< int >( i ) } );
+			}
+		} ), "ns/publish" );
+
+		a_Report.Add( "event bus", "unordered_map<string, Delegate>", 1, Measure( a_Calls, [ & ]()
+		{
+			for ( size_t i = 0; i < a_Calls; ++i )
+			{
+				ByName[ Name ].InvokeAll( HitEvent{ static_cast< int >( i ) } );
+			}
+		} ), "ns/publish" );
+	}
+
+	struct EntityEvent { uint32_t Entity; int Value; };
+
+	/// <summary>
+	/// Broadcasts that concern one entity to subscribers that each follow
+	/// one, filtered on Add against each one returning early on a mismatch.
+	/// </summary>
+	void FilteredDispatch( Report& a_Report, size_t a_Calls )
+	{
+		for ( size_t Subscribers = 100; Subscribers <= 100000; Subscribers *= 10 )
+		{
+			Delegate< void, const EntityEvent& > Filtered;
+			Delegate< void, const EntityEvent& > Checked;
+
+			for ( size_t i = 0; i < Subscribers; ++i )
+			{
+				const uint32_t Entity = static_cast< uint32_t >( i );
+				Filtered.Add( MakeFilter< 0 >( &EntityEvent::Entity, Entity ), []( const EntityEvent& a_Event ) { s_Sink += a_Event.Value; } );
+				Checked.Add( [ Entity ]( const EntityEvent& a_Event )
+				{
+					if ( a_Event.Entity == Entity )
+					{
+						s_Sink += a_Event.Value;
+					}
+				} );
+			}
+
+			const size_t Broadcasts = a_Calls / Subscribers ? a_Calls / Subscribers : 1;
+
+			auto Run = [ & ]( Delegate< void, const EntityEvent& >& a_Delegate )
+			{
+				for ( size_t i = 0; i < Broadcasts; ++i )
+				{
+					a_Delegate.InvokeAll( EntityEvent{ static_cast< uint32_t >( i * 7919 % Subscribers ), 1 } );
+				}
+			};
+
+			a_Report.Add( "filtered", "Add(MakeFilter)", Subscribers, Measure( Broadcasts, [ & ]() { Run( Filtered ); } ), "ns/broadcast" );
+			a_Report.Add( "filtered", "early return in subscriber", Subscribers, Measure( Broadcasts, [ & ]() { Run( Checked ); } ), "ns/broadcast" );
+		}
+	}
+
+	/// <summary>
+	/// Broadcast cost with a DelegateRecorder attached against without, then
+	/// replaying the log at maximum speed against broadcasting the same
+	/// events directly.
+	/// </summary>
+	void Recording( Report& a_Report, size_t a_Calls, size_t a_Subscribers = 16 )
+	{
+		const char* Path = "benchmark.dlog";
+		const size_t Broadcasts = a_Calls / a_Subscribers;
+		Delegate< void, const EntityEvent& > Subject;
+
+		for ( size_t i = 0; i < a_Subscribers; ++i )
+		{
+			Subject.Add( []( const EntityEvent& a_Event ) { s_Sink += a_Event.Value; } );
+		}
+
+		auto Run = [ & ]()
+		{
+			for ( size_t i = 0; i < Broadcasts; ++i )
+			{
+				Subject.InvokeAll( EntityEvent{ static_cast< uint32_t >( i ), static_cast< int >( i ) } );
+			}
+		};
+
+		a_Report.Add( "recording", "InvokeAll", a_Subscribers, Measure( Broadcasts, Run ), "ns/broadcast" );
+
+		{
+			DelegateRecorder< const EntityEvent& > Recorder( Path );
+			ScopedConnection Connection = Recorder.Attach( Subject );
+			a_Report.Add( "recording", "InvokeAll+DelegateRecorder", a_Subscribers, Measure( Broadcasts, Run ), "ns/broadcast" );
+		}
+
+		DelegateReplayer< const EntityEvent& > Replayer( Path );
+		const size_t Records = Replayer.GetCount();
+
+		a_Report.Add( "recording", "DelegateReplayer::Play", a_Subscribers, Measure( Records, [ & ]()
+		{
+			Replayer.Play( Subject );
+		} ), "ns/broadcast" );
+
+		Replayer.Close();
+		remove( Path );
+	}
+
+	/// <summary>
+	/// A frame in which a few of many properties change several times each.
+	/// Broadcasting every change against coalescing them and flushing the
+	/// registry once per frame.
+	/// </summary>
+	void Coalescing( Report& a_Report, size_t a_Calls, size_t a_Properties = 1000, size_t a_Changed = 10, size_t a_Repeats = 32, size_t a_Subscribers = 16 )
+	{
+		const size_t Frames = a_Calls / ( a_Changed * a_Repeats * a_Subscribers ) ? a_Calls / ( a_Changed * a_Repeats * a_Subscribers ) : 1;
+		auto Handler = []( const EntityEvent& a_Event ) { s_Sink += a_Event.Value; };
+
+		vector< Delegate< void, const EntityEvent& > > Immediate( a_Properties );
+		CoalescingRegistry Registry;
+		vector< unique_ptr< CoalescingDelegate< const EntityEvent& > > > Coalesced;
+
+		for ( size_t i = 0; i < a_Properties; ++i )
+		{
+			Coalesced.emplace_back( new CoalescingDelegate< const EntityEvent& >( Registry ) );
+
+			for ( size_t j = 0; j < a_Subscribers; ++j )
+			{
+				Immediate[ i ].Add( Handler );
+				Coalesced[ i ]->Add( Handler );
+			}
+		}
+
+		auto Run = [ & ]( auto&& a_Change, auto&& a_EndFrame )
+		{
+			for ( size_t Frame = 0; Frame < Frames; ++Frame )
+			{
+				for ( size_t Repeat = 0; Repeat < a_Repeats; ++Repeat )
+				{
+					for ( size_t i = 0; i < a_Changed; ++i )
+					{
+						a_Change( ( Frame * 7919 + i * 104729 ) % a_Properties, EntityEvent{ static_cast< uint32_t >( i ), static_cast< int >( Repeat ) } );
+					}
+				}
+
+				a_EndFrame();
+			}
+		};
+
+		a_Report.Add( "coalescing", "InvokeAll per change", a_Properties, Measure( Frames, [ & ]()
+		{
+			Run( [ & ]( size_t a_Index, const EntityEvent& a_Event ) { Immediate[ a_Index ].InvokeAll( a_Event ); }, []() { } );
+		} ), "ns/frame" );
+
+		a_Report.Add( "coalescing", "CoalescingDelegate+Registry::Flush", a_Properties, Measure( Frames, [ & ]()
+		{
+			Run( [ & ]( size_t a_Index, const EntityEvent& a_Event ) { Coalesced[ a_Index ]->Invoke( a_Event ); }, [ & ]() { Registry.Flush(); } );
+		} ), "ns/frame" );
+	}
+
+	/// <summary>
+	/// Broadcasting through a tree of delegates a_Fanout wide and a_Depth
+	/// deep, each holding a_Subscribers subscribers. Children attached by
+	/// reference against each one wrapped in a lambda calling its InvokeAll,
+	/// and against copying all subscribers into the root with Add.
+	/// </summary>
+	void NestedDispatch( Report& a_Report, size_t a_Calls, size_t a_Fanout = 4, size_t a_Depth = 3, size_t a_Subscribers = 4 )
+	{
+		using IntDelegate = Delegate< void, int >;
+		auto Handler = []( int a_Value ) { s_Sink += a_Value; };
+
+		deque< IntDelegate > Attached;
+		deque< IntDelegate > Wrapped;
+		IntDelegate Copied;
+
+		// Builds both trees level by level, a node's children follow it.
+		auto Build = [ & ]( deque< IntDelegate >& a_Nodes, bool a_IsAttached )
+		{
+			a_Nodes.emplace_back();
+			size_t Begin = 0;
+
+			for ( size_t Level = 1; Level < a_Depth; ++Level )
+			{
+				const size_t End = a_Nodes.size();
+
+				for ( size_t Parent = Begin; Parent < End; ++Parent )
+				{
+					for ( size_t i = 0; i < a_Fanout; ++i )
+					{
+						a_Nodes.emplace_back();
+						IntDelegate& Child = a_Nodes.back();
+
+						if ( a_IsAttached )
+						{
+							a_Nodes[ Parent ].Attach( Child );
+						}
+						else
+						{
+							a_Nodes[ Parent ].Add( [ &Child ]( int a_Value ) { Child.InvokeAll( a_Value ); } );
+						}
+					}
+				}
+
+				Begin = End;
+			}
+
+			for ( IntDelegate& Node : a_Nodes )
+			{
+				for ( size_t i = 0; i < a_Subscribers; ++i )
+				{
+					Node.Add( Handler );
+				}
+			}
+		};
+
+		Build( Attached, true );
+		Build( Wrapped, false );
+
+		for ( size_t i = 0; i < Attached.size() * a_Subscribers; ++i )
+		{
+			Copied.Add( Handler );
+		}
+
+		const size_t Subscribers = Attached.size() * a_Subscribers;
+		const size_t Broadcasts = a_Calls / Subscribers;
+
+		auto Run = [ & ]( IntDelegate& a_Root )
+		{
+			for ( size_t i = 0; i < Broadcasts; ++i )
+			{
+				a_Root.InvokeAll( static_cast< int >( i ) );
+			}
+		};
+
+		a_Report.Add( "nested", "Attach", Subscribers, Measure( Broadcasts, [ & ]() { Run( Attached.front() ); } ), "ns/broadcast" );
+		a_Report.Add( "nested", "lambda calling InvokeAll", Subscribers, Measure( Broadcasts, [ & ]() { Run( Wrapped.front() ); } ), "ns/broadcast" );
+		a_Report.Add( "nested", "Add(const Delegate&) copy", Subscribers, Measure( Broadcasts, [ & ]() { Run( Copied ); } ), "ns/broadcast" );
+	}
+
+	/// <summary>
+	/// Broadcasting to subscribers that must run on another thread, bound to
+	/// its executor against each wrapping itself in a lambda that pushes to
+	/// a mutex guarded queue. The executor belongs to no running thread, so
+	/// every call is posted, and both inboxes are drained every 64
+	/// broadcasts on the measuring thread.
+	/// </summary>
+	void AffineDispatch( Report& a_Report, size_t a_Calls, size_t a_Subscribers = 16 )
+	{
+		const size_t Broadcasts = a_Calls / a_Subscribers;
+		auto Handler = []( int a_Value ) { s_Sink += a_Value; };
+
+		DelegateExecutor Executor( ( thread::id() ) );
+		Delegate< void, int > Bound;
+
+		mutex QueueMutex;
+		deque< function< void() > > Queue;
+		Delegate< void, int > Wrapped;
+
+		for ( size_t i = 0; i < a_Subscribers; ++i )
+		{
+			Bound.Add( Executor, Handler );
+			Wrapped.Add( [ &, Handler ]( int a_Value )
+			{
+				lock_guard< mutex > Lock( QueueMutex );
+				Queue.push_back( [ Handler, a_Value ]() { Handler( a_Value ); } );
+			} );
+		}
+
+		a_Report.Add( "affinity", "Add(DelegateExecutor&)", a_Subscribers, Measure( Broadcasts, [ & ]()
+		{
+			for ( size_t i = 0; i < Broadcasts; ++i )
+			{
+				Bound.InvokeAll( static_cast< int >( i ) );
+
+				if ( i % 64 == 63 )
+				{
+					Executor.Pump();
+				}
+			}
+
+			Executor.Pump();
+		} ), "ns/broadcast" );
+
+		a_Report.Add( "affinity", "mutex queue per subscriber", a_Subscribers, Measure( Broadcasts, [ & ]()
+		{
+			for ( size_t i = 0; i < Broadcasts; ++i )
+			{
+				Wrapped.InvokeAll( static_cast< int >( i ) );
+
+				if ( i % 64 == 63 )
+				{
+					lock_guard< mutex > Lock( QueueMutex );
+
+					for ( ; !Queue.empty(); Queue.pop_front() )
+					{
+						Queue.front()();
+					}
+				}
+			}
+
+			for ( ; !Queue.empty(); Queue.pop_front() )
+			{
+				Queue.front()();
+			}
+		} ), "ns/broadcast" );
+	}
+
+	/// <summary>
+	/// Broadcasts over subscribers of eight thunk and target kinds in random
+	/// order, once as an Ordered and once as an Unordered delegate.
+	/// </summary>
+	void GroupedDispatch( Report& a_Report, size_t a_Subscribers = 4096, size_t a_Broadcasts = 2000 )
+	{
+		MemberTick< 1 > Member1;
+		MemberTick< 2 > Member2;
+		Delegate< void, int > Ordered;
+		mt19937 Random( 42 );
+
+		for ( size_t i = 0; i < a_Subscribers; ++i )
+		{
+			switch ( Random() % 8 )
+			{
+			case 0: Ordered.Add( StaticTick< 0 > ); break;
+			case 1: Ordered.Add( StaticTick< 1 > ); break;
+			case 2: Ordered.Add( StaticTick< 2 > ); break;
+			case 3: Ordered.Add( Member1, &MemberTick< 1 >::Tick ); break;
+			case 4: Ordered.Add( Member2, &MemberTick< 2 >::Tick ); break;
+			case 5: Ordered.Add( []( int a_Value ) { s_Sink += a_Value ^ 5; } ); break;
+			case 6: Ordered.Add( []( int a_Value ) { s_Sink += a_Value ^ 6; } ); break;
+			case 7: Ordered.Add( []( int a_Value ) { s_Sink += a_Value ^ 7; } ); break;
+			}
+		}
+
+		Delegate< void, int > Unordered( Ordered );
+		Unordered.SetOrdering( DelegateOrdering::Unordered );
+
+		auto Run = [ & ]( const char* a_Name, Delegate< void, int >& a_Delegate )
+		{
+			BranchMissCounter Counter;
+			a_Delegate.InvokeAll( 0 );
+
+			const auto Start = chrono::steady_clock::now();
+			Counter.Start();
+
+			for ( size_t i = 0; i < a_Broadcasts; ++i )
+			{
+				a_Delegate.InvokeAll( static_cast< int >( i ) );
+			}
+
+			const uint64_t Misses = Counter.Stop();
+			const chrono::duration< double, nano > Elapsed = chrono::steady_clock::now() - Start;
+			const double Calls = static_cast< double >( a_Subscribers * a_Broadcasts );
+
+			a_Report.Add( "grouped", a_Name, a_Subscribers, Elapsed.count() / Calls, "ns/call" );
+
+			if ( Counter.IsAvailable() )
+			{
+				a_Report.Add( "grouped", string( a_Name ) + " branch misses", a_Subscribers, static_cast< double >( Misses ) / Calls, "misses/call" );
+			}
+		};
+
+		Run( "ordered", Ordered );
+		Run( "unordered", Unordered );
+	}
+
+	/// <summary>
+	/// A large payload that counts how often it is copied and moved.
+	/// </summary>
+	struct CountedPayload
+	{
+		static size_t s_Copies;
+		static size_t s_Moves;
+
+		CountedPayload() { }
+		CountedPayload( const CountedPayload& a_Other ) : m_Data( a_Other.m_Data ) { ++s_Copies; }
+		CountedPayload( CountedPayload&& a_Other ) : m_Data( a_Other.m_Data ) { ++s_Moves; }
+
+		array< uint64_t, 32 > m_Data = { };
+	};
+
+	size_t CountedPayload::s_Copies = 0;
+	size_t CountedPayload::s_Moves = 0;
+
+	void ConsumePayload( CountedPayload a_Payload )
+	{
+		s_Sink += a_Payload.m_Data[ 0 ];
+	}
+
+	/// <summary>
+	/// Broadcasts a by value payload to subscribers that take it by const
+	/// reference and to ones that take it by value. Only the latter should
+	/// copy, once each.
+	/// </summary>
+	void ArgumentForwarding( Report& a_Report, size_t a_Subscribers = 64, size_t a_Broadcasts = 1000 )
+	{
+		Delegate< void, CountedPayload > Observers;
+		Delegate< void, CountedPayload > Consumers;
+
+		for ( size_t i = 0; i < a_Subscribers; ++i )
+		{
+			Observers.Add( []( const CountedPayload& a_Payload ) { s_Sink += a_Payload.m_Data[ 0 ]; } );
+			Consumers.Add( ConsumePayload );
+		}
+
+		auto Run = [ & ]( const char* a_Name, Delegate< void, CountedPayload >& a_Delegate )
+		{
+			CountedPayload Payload;
+			CountedPayload::s_Copies = 0;
+			CountedPayload::s_Moves = 0;
+
+			for ( size_t i = 0; i < a_Broadcasts; ++i )
+			{
+				a_Delegate.InvokeAll( Payload );
+			}
+
+			const double Calls = static_cast< double >( a_Subscribers * a_Broadcasts );
+			a_Report.Add( "forwarding", string( a_Name ) + " copies", a_Subscribers, CountedPayload::s_Copies / Calls, "copies/call" );
+			a_Report.Add( "forwarding", string( a_Name ) + " moves", a_Subscribers, CountedPayload::s_Moves / Calls, "moves/call" );
+		};
+
+		Run( "by reference", Observers );
+		Run( "by value", Consumers );
+
+		Invoker< size_t, unique_ptr< CountedPayload > > Owner( []( unique_ptr< CountedPayload > a_Payload ) { return a_Payload->m_Data.size(); } );
+		s_Sink += Owner( unique_ptr< CountedPayload >( new CountedPayload() ) );
+	}
+}
+
+/// <summary>
+/// Usage: Benchmark [--quick] [--json path]
+/// Results are written to benchmark.json unless another path is given.
+/// </summary>
+int main( int argc, char** argv )
+{
+	const char* Path = "benchmark.json";
+	size_t Calls = 10000000;
+
+	for ( int i = 1; i < argc; ++i )
+	{
+		if ( strcmp( argv[ i ], "--quick" ) == 0 )
+		{
+			Calls = 100000;
+		}
+		else if ( strcmp( argv[ i ], "--json" ) == 0 && i + 1 < argc )
+		{
+			Path = argv[ ++i ];
+		}
+		else
+		{
+			cerr << "Usage: " << argv[ 0 ] << " [--quick] [--json path]" << endl;
+			return 1;
+		}
+	}
+
+	Benchmark::Report Report;
+	Benchmark::CallOverhead( Report, Calls );
+	Benchmark::InvokeAllScaling( Report, Calls );
+	Benchmark::Instrumentation( Report, Calls );
+	Benchmark::Churn( Report, Calls );
+	Benchmark::IndexedAccess( Report, Calls );
+	Benchmark::BulkRemoval( Report, Calls );
+	Benchmark::AllocationChurn< int >( Report, "std::allocator", Calls );
+	Benchmark::AllocationChurn< short >( Report, "DelegatePoolAllocator", Calls );
+	Benchmark::EventBusPublish( Report, Calls );
+	Benchmark::AffineDispatch( Report, Calls );
+	Benchmark::FilteredDispatch( Report, Calls );
+	Benchmark::Recording( Report, Calls );
+	Benchmark::Coalescing( Report, Calls );
+	Benchmark::NestedDispatch( Report, Calls );
+	Benchmark::GroupedDispatch( Report );
+	Benchmark::ArgumentForwarding( Report );
+
+	ofstream Stream( Path );
+
+	if ( !Stream )
+	{
+		cerr << "Cannot write " << Path << endl;
+		return 1;
+	}
+
+	Report.Write( Stream );
+	cout << "Wrote " << Path << " (sink " << Benchmark::s_Sink << ")" << endl;
+	return 0;
+}
@@ -0,0 +1,7163 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <functional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <immintrin.h>
+#define DELEGATE_HAS_SSE2
+#endif
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DELEGATE_HAS_MMAP
+#endif
+
+#if defined( __cpp_impl_coroutine ) && defined( __has_include )
+#if __has_include( <coroutine> )
+#include <coroutine>
+#define DELEGATE_HAS_COROUTINES
+#endif
+#endif
+
+//==========================================================================
+template < typename, typename... >
+class Invoker;
+
+namespace FunctionTraits
+{
+	template < typename T >
+	struct FunctionInfo;
+
+	template < typename R, typename... A >
+	struct FunctionInfo< R( A... ) >
+	{
+		using Signature = R( A... );
+		using Return = R;
+		using Arguments = std::tuple< A... >;
+		static constexpr bool IsStatic = true;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = false;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename O, typename R, typename... A >
+	struct FunctionInfo< R( O::* )( A... ) >
+		: FunctionInfo< R( A... ) >
+	{
+		static constexpr bool IsStatic = false;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = true;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename O, typename R, typename... A >
+	struct FunctionInfo< R( O::* )( A... ) const >
+		: FunctionInfo< R( A... ) >
+	{
+		static constexpr bool IsStatic = false;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = true;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename O, typename R, typename... A >
+	struct FunctionInfo< R( O::* )( A... ) volatile >
+		: FunctionInfo< R( A... ) >
+	{
+		static constexpr bool IsStatic = false;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = true;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename O, typename R, typename... A >
+	struct FunctionInfo< R( O::* )( A... ) const volatile >
+		: FunctionInfo< R( A... ) >
+	{
+		static constexpr bool IsStatic = false;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = true;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename R, typename... A >
+	struct FunctionInfo< R( * )( A... ) >
+		: FunctionInfo< R( A... ) >
+	{
+		static constexpr bool IsStatic = true;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = false;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename R, typename... A >
+	struct FunctionInfo< R( & )( A... ) >
+		: FunctionInfo< R( A... ) >
+	{
+		static constexpr bool IsStatic = true;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = false;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename... >
+	using VoidT = void;
+
+	template < typename T, typename = void >
+	struct CallableInfo
+	{
+		static constexpr bool IsStatic = false;
+		static constexpr bool IsLambda = false;
+		static constexpr bool IsMember = false;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename T >
+	struct CallableInfo< T, VoidT< decltype( &std::remove_reference< T >::type::operator() ) > >
+	{
+		using Signature = typename FunctionInfo< decltype( &std::remove_reference< T >::type::operator() ) >::Signature;
+		using Return = typename FunctionInfo< Signature >::Return;
+		using Arguments = typename FunctionInfo< Signature >::Arguments;
+		static constexpr bool IsStatic = false;
+		static constexpr bool IsLambda = true;
+		static constexpr bool IsMember = false;
+		static constexpr bool IsFunction = IsStatic || IsLambda || IsMember;
+	};
+
+	template < typename T >
+	struct FunctionInfo
+		: CallableInfo< T >
+	{ };
+
+	template < typename T >
+	using GetSignature = typename FunctionInfo< T >::Signature;
+
+	template < typename T >
+	using GetReturn = typename FunctionInfo< T >::Return;
+
+	template < typename T >
+	using GetArguments = typename FunctionInfo< T >::Arguments;
+
+	template < typename R, typename... A >
+	struct ConvertToInvokerImpl
+	{
+		using Type = Invoker< R, A... >;
+	};
+
+	template < typename R, typename... A >
+	struct ConvertToInvokerImpl< R, std::tuple< A... > >
+	{
+		using Type = Invoker< R, A... >;
+	};
+
+	template < typename T >
+	using ConvertToInvoker = ConvertToInvokerImpl< GetReturn< T >, GetArguments< T > >;
+
+	template < typename T >
+	using EnableIfLambdaF = std::enable_if_t< FunctionInfo< T >::IsLambda, void >;
+
+	template < typename T >
+	using DisableIfLambdaF = std::enable_if_t< !FunctionInfo< T >::IsLambda, void >;
+
+	template < typename T >
+	using EnableIfStaticF = std::enable_if_t< FunctionInfo< T >::IsStatic, void >;
+
+	template < typename T >
+	using DisableIfStaticF = std::enable_if_t< !FunctionInfo< T >::IsStatic, void >;
+
+	template < typename T >
+	using EnableIfMemberF = std::enable_if_t< FunctionInfo< T >::IsMember, void >;
+
+	template < typename T >
+	using DisableIfMemberF = std::enable_if_t< !FunctionInfo< T >::IsMember, void >;
+
+	template < typename T >
+	using EnableIfFunction = std::enable_if_t< FunctionInfo< T >::IsFunction, void >;
+
+	template < typename T >
+	using DisableIfFunction = std::enable_if_t< !FunctionInfo< T >::IsFunction, void >;
+
+	/// <summary>
+	/// How an argument travels through a thunk. References pass through as
+	/// declared, values are lent as const references and only move only
+	/// values are handed over as rvalues, so no copy is ever made on the way
+	/// to the target.
+	/// </summary>
+	template < typename Arg >
+	using ForwardType = std::conditional_t< std::is_reference< Arg >::value, Arg,
+						std::conditional_t< std::is_copy_constructible< Arg >::value, const Arg&, Arg&& > >;
+
+	template < typename Arg >
+	inline ForwardType< Arg > Pass( std::remove_reference_t< ForwardType< Arg > >& a_Arg )
+	{
+		return static_cast< ForwardType< Arg > >( a_Arg );
+	}
+
+	template < bool... Values >
+	struct AllOf
+		: std::is_same< AllOf< Values... >, AllOf< ( Values || true )... > >
+	{ };
+
+	template < typename Expected, typename Given, bool = std::tuple_size< Expected >::value == std::tuple_size< Given >::value >
+	struct ArgumentsMatch
+		: std::false_type
+	{ };
+
+	template < typename... A, typename... P >
+	struct ArgumentsMatch< std::tuple< A... >, std::tuple< P... >, true >
+		: AllOf< std::is_convertible< P&&, A >::value... >
+	{ };
+
+	template < typename Expected, typename... Given >
+	using EnableIfArguments = std::enable_if_t< ArgumentsMatch< Expected, std::tuple< Given... > >::value, void >;
+
+	/// <summary>
+	/// Arguments that can be copied are shared between targets, a broadcast
+	/// cannot hand the same move only value to more than one of them.
+	/// </summary>
+	template < typename... A >
+	using IsBroadcastable = AllOf< ( std::is_reference< A >::value || std::is_copy_constructible< A >::value )... >;
+
+	/// <summary>
+	/// Whether Combiner can be called with each Return of a broadcast and
+	/// answers with a bool whether to go on.
+	/// </summary>
+	template < typename Combiner, typename Return, typename = void >
+	struct IsCombiner
+		: std::false_type
+	{ };
+
+	template < typename Combiner, typename Return >
+	struct IsCombiner< Combiner, Return, VoidT< decltype( std::declval< Combiner& >()( std::declval< Return >() ) ) > >
+		: std::is_convertible< decltype( std::declval< Combiner& >()( std::declval< Return >() ) ), bool >
+	{ };
+
+	template < typename Combiner, typename Return, typename Expected, typename... Given >
+	using EnableIfCombiner = std::enable_if_t< IsCombiner< std::remove_reference_t< Combiner >, Return >::value &&
+										  ArgumentsMatch< Expected, std::tuple< Given... > >::value, void >;
+
+	/// <summary>
+	/// Position of T in Types, sizeof...( Types ) when it is not one of them.
+	/// </summary>
+	template < typename T, typename... Types >
+	struct TypeIndex
+		: std::integral_constant< size_t, 0 >
+	{ };
+
+	template < typename T, typename First, typename... Rest >
+	struct TypeIndex< T, First, Rest... >
+		: std::integral_constant< size_t, std::is_same< T, First >::value ? 0 : 1 + TypeIndex< T, Rest... >::value >
+	{ };
+
+	/// <summary>
+	/// Binds a call argument to the ForwardType a thunk expects. Anything
+	/// that binds directly is referenced, anything else is converted into a
+	/// temporary that lives until the end of the full expression.
+	/// </summary>
+	template < typename Arg, typename Param,
+			   bool = std::is_convertible< std::remove_reference_t< Param >*, std::remove_reference_t< ForwardType< Arg > >* >::value >
+	class Forwarder
+	{
+	public:
+
+		Forwarder( Param&& a_Param )
+			: m_Value( a_Param )
+		{ }
+
+		inline ForwardType< Arg > Get() const
+		{
+			return static_cast< ForwardType< Arg > >( m_Value );
+		}
+
+	private:
+
+		std::remove_reference_t< ForwardType< Arg > >& m_Value;
+	};
+
+	template < typename Arg, typename Param >
+	class Forwarder< Arg, Param, false >
+	{
+	public:
+
+		Forwarder( Param&& a_Param )
+			: m_Value( std::forward< Param >( a_Param ) )
+		{ }
+
+		inline ForwardType< Arg > Get()
+		{
+			return static_cast< ForwardType< Arg > >( m_Value );
+		}
+
+	private:
+
+		std::decay_t< Arg > m_Value;
+	};
+}
+
+#ifndef INVOKER_BUFFER_SIZE
+#define INVOKER_BUFFER_SIZE ( 2 * sizeof( void* ) )
+#endif
+
+//==========================================================================
+// Thread local free lists of fixed size blocks, used for lambda captures
+// that do not fit in an Invoker's inline buffer, for lambdas owned by a
+// Delegate and by DelegatePoolAllocator. A block goes back to the list of
+// the thread freeing it. A list that grows past MaxCachedBlocks, because
+// its thread frees what others allocate, spills a batch into shared lists
+// that every thread refills from.
+//==========================================================================
+class LambdaPool
+{
+public:
+
+	/// <summary>
+	/// Blocks are aligned for any fundamental type. Larger sizes and
+	/// stricter alignments go to the heap.
+	/// </summary>
+	static void* Allocate( size_t a_Size, size_t a_Alignment = alignof( std::max_align_t ) )
+	{
+		if ( a_Alignment > alignof( std::max_align_t ) )
+		{
+			return ::operator new( a_Size, std::align_val_t( a_Alignment ) );
+		}
+
+		const size_t Class = GetClass( a_Size );
+
+		if ( Class == ClassCount )
+		{
+			return ::operator new( a_Size );
+		}
+
+		ThreadCache& Cache = GetThreadCache();
+
+		if ( !Cache.Heads[ Class ] )
+		{
+			Refill( Cache, Class );
+		}
+
+		Block* Result = Cache.Heads[ Class ];
+		Cache.Heads[ Class ] = Result->Next;
+		--Cache.Counts[ Class ];
+		return Result;
+	}
+
+	/// <summary>
+	/// Takes the size and alignment the block was allocated with.
+	/// </summary>
+	static void Free( void* a_Block, size_t a_Size, size_t a_Alignment = alignof( std::max_align_t ) )
+	{
+		if ( a_Alignment > alignof( std::max_align_t ) )
+		{
+			::operator delete( a_Block, std::align_val_t( a_Alignment ) );
+			return;
+		}
+
+		const size_t Class = GetClass( a_Size );
+
+		if ( Class == ClassCount )
+		{
+			::operator delete( a_Block );
+			return;
+		}
+
+		ThreadCache& Cache = GetThreadCache();
+		Block* Freed = static_cast< Block* >( a_Block );
+		Freed->Next = Cache.Heads[ Class ];
+		Cache.Heads[ Class ] = Freed;
+
+		if ( ++Cache.Counts[ Class ] > MaxCachedBlocks )
+		{
+			Spill( Cache, Class );
+		}
+	}
+
+private:
+
+	struct Block
+	{
+		Block* Next;
+	};
+
+	static constexpr size_t MinBlockSize    = 16;
+	static constexpr size_t ClassCount      = 6;
+	static constexpr size_t BlocksPerChunk  = 64;
+	static constexpr size_t MaxCachedBlocks = 2 * BlocksPerChunk;
+
+	static inline size_t GetBlockSize( size_t a_Class )
+	{
+		return MinBlockSize << a_Class;
+	}
+
+	static inline size_t GetClass( size_t a_Size )
+	{
+		size_t Class = 0;
+
+		while ( Class < ClassCount && GetBlockSize( Class ) < a_Size )
+		{
+			++Class;
+		}
+
+		return Class;
+	}
+
+	/// <summary>
+	/// Blocks spilled by threads with too many cached and the free lists
+	/// of exited threads, picked up again by Refill. Never destroyed,
+	/// threads may still exit during static destruction.
+	/// </summary>
+	struct SharedLists
+	{
+		std::mutex Mutex;
+		Block*     Heads[ ClassCount ];
+	};
+
+	struct ThreadCache
+	{
+		~ThreadCache()
+		{
+			SharedLists& Shared = GetSharedLists();
+			std::lock_guard< std::mutex > Lock( Shared.Mutex );
+
+			for ( size_t i = 0; i < ClassCount; ++i )
+			{
+				while ( Heads[ i ] )
+				{
+					Block* Current = Heads[ i ];
+					Heads[ i ] = Current->Next;
+					Current->Next = Shared.Heads[ i ];
+					Shared.Heads[ i ] = Current;
+				}
+			}
+		}
+
+		Block* Heads[ ClassCount ] = { };
+		size_t Counts[ ClassCount ] = { };
+	};
+
+	static inline ThreadCache& GetThreadCache()
+	{
+		thread_local ThreadCache s_Cache;
+		return s_Cache;
+	}
+
+	static inline SharedLists& GetSharedLists()
+	{
+		static SharedLists* s_Shared = new SharedLists();
+		return *s_Shared;
+	}
+
+	/// <summary>
+	/// Takes up to a chunk's worth of blocks from the shared lists, and
+	/// carves a new chunk only when they are empty.
+	/// </summary>
+	static void Refill( ThreadCache& a_Cache, size_t a_Class )
+	{
+		{
+			SharedLists& Shared = GetSharedLists();
+			std::lock_guard< std::mutex > Lock( Shared.Mutex );
+
+			while ( Shared.Heads[ a_Class ] && a_Cache.Counts[ a_Class ] < BlocksPerChunk )
+			{
+				Block* Current = Shared.Heads[ a_Class ];
+				Shared.Heads[ a_Class ] = Current->Next;
+				Current->Next = a_Cache.Heads[ a_Class ];
+				a_Cache.Heads[ a_Class ] = Current;
+				++a_Cache.Counts[ a_Class ];
+			}
+
+			if ( a_Cache.Heads[ a_Class ] )
+			{
+				return;
+			}
+		}
+
+		// Chunks are never handed back, their blocks cycle through the free lists instead.
+		const size_t BlockSize = GetBlockSize( a_Class );
+		char* Chunk = static_cast< char* >( ::operator new( BlockSize * BlocksPerChunk ) );
+
+		for ( size_t i = 0; i < BlocksPerChunk; ++i )
+		{
+			Block* Current = reinterpret_cast< Block* >( Chunk + i * BlockSize );
+			Current->Next = a_Cache.Heads[ a_Class ];
+			a_Cache.Heads[ a_Class ] = Current;
+		}
+
+		a_Cache.Counts[ a_Class ] = BlocksPerChunk;
+	}
+
+	/// <summary>
+	/// Hands a chunk's worth of the thread's cached blocks to the shared
+	/// lists, keeping the rest for the thread's own allocations.
+	/// </summary>
+	static void Spill( ThreadCache& a_Cache, size_t a_Class )
+	{
+		SharedLists& Shared = GetSharedLists();
+		std::lock_guard< std::mutex > Lock( Shared.Mutex );
+
+		for ( size_t i = 0; i < BlocksPerChunk; ++i )
+		{
+			Block* Current = a_Cache.Heads[ a_Class ];
+			a_Cache.Heads[ a_Class ] = Current->Next;
+			Current->Next = Shared.Heads[ a_Class ];
+			Shared.Heads[ a_Class ] = Current;
+		}
+
+		a_Cache.Counts[ a_Class ] -= BlocksPerChunk;
+	}
+
+};
+
+//==========================================================================
+// Standard allocator over the LambdaPool's fixed size blocks. Requests that
+// fit a size class are served from the calling thread's free lists, larger
+// ones from the heap. It is stateless, so every container using it, in
+// every delegate, recycles the same blocks.
+//==========================================================================
+template < typename T >
+class DelegatePoolAllocator
+{
+public:
+
+	static_assert( alignof( T ) <= alignof( std::max_align_t ), "Pool blocks are only aligned for fundamental types." );
+
+	using value_type = T;
+
+	DelegatePoolAllocator() = default;
+
+	template < typename U >
+	DelegatePoolAllocator( const DelegatePoolAllocator< U >& )
+	{ }
+
+	inline T* allocate( size_t a_Count )
+	{
+		return static_cast< T* >( LambdaPool::Allocate( a_Count * sizeof( T ) ) );
+	}
+
+	inline void deallocate( T* a_Pointer, size_t a_Count )
+	{
+		LambdaPool::Free( a_Pointer, a_Count * sizeof( T ) );
+	}
+
+	template < typename U >
+	inline bool operator==( const DelegatePoolAllocator< U >& ) const { return true; }
+
+	template < typename U >
+	inline bool operator!=( const DelegatePoolAllocator< U >& ) const { return false; }
+
+};
+
+enum class LambdaOperation
+{
+	Copy,
+	Move,
+	Destroy,
+	Compare,
+	Hash
+};
+
+//==========================================================================
+// Type erased callable. Every form shares one layout, the thunk, object,
+// function and manager words plus an inline buffer for small captures
+// and runtime member function pointers, 48 bytes on 64 bit targets. A
+// Bind< Fn > invoker is called through its thunk and object alone, its
+// function and manager words only give it an identity to compare and
+// remove it by. Delegate keeps the four words as columns per subscriber.
+//==========================================================================
+template < typename Return = void, typename... Args >
+class Invoker
+{
+public:
+
+	template < typename Object >
+	using MemberFunction     = Return( Object::* )( Args... );
+	using StaticFunction     = Return( * )( Args... );
+	using InvocationFunction = Return( * )( void*, void*, FunctionTraits::ForwardType< Args >... );
+	using LambdaManager      = void*( * )( LambdaOperation, void*, void* );
+	using Signature          = Return( Args... );
+
+	static constexpr size_t BufferSize = INVOKER_BUFFER_SIZE;
+
+	/// <summary>
+	/// 
+	/// </summary>
+	Invoker()
+		: m_Invocation( nullptr )
+		, m_Object( nullptr )
+		, m_Function( nullptr )
+		, m_Manager( nullptr )
+	{ }
+
+	/// <summary>
+	/// 
+	/// </summary>
+	Invoker( const Invoker& a_Other )
+		: m_Invocation( nullptr )
+		, m_Object( nullptr )
+		, m_Function( nullptr )
+		, m_Manager( nullptr )
+	{
+		CopyFrom( a_Other );
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	Invoker( Invoker&& a_Other )
+		: m_Invocation( nullptr )
+		, m_Object( nullptr )
+		, m_Function( nullptr )
+		, m_Manager( nullptr )
+	{
+		MoveFrom( a_Other );
+	}
+
+	/// <summary>
+	/// Takes ownership of the lambda. Captures up to BufferSize bytes live
+	/// inline, larger ones are placed in the LambdaPool and over-aligned
+	/// ones on the heap.
+	/// </summary>
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	Invoker( Lambda a_Lambda )
+		: m_Invocation( FunctorLambda< Lambda > )
+		, m_Object( StoreLambda( a_Lambda ) )
+		, m_Function( nullptr )
+		, m_Manager( ManageLambda< Lambda > )
+	{ }
+
+	/// <summary>
+	/// Member function pointers can be wider than a void* and carry this
+	/// adjustments for multiple and virtual inheritance. The pointer is
+	/// kept in the inline buffer and managed like a lambda's captures,
+	/// m_Function addresses it. A Delegate keeps it in a LambdaPool block,
+	/// Bind avoids that block and the load through it per call.
+	/// </summary>
+	template < typename Object >
+	Invoker( Object* a_ObjectInstance, MemberFunction< Object > a_MemberFunction )
+		: m_Invocation( FunctorMember< Object > )
+		, m_Object( a_ObjectInstance )
+		, m_Function( StoreLambda( a_MemberFunction ) )
+		, m_Manager( ManageLambda< MemberFunction< Object > > )
+	{ }
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename Object >
+	Invoker( Object& a_ObjectInstance, MemberFunction< Object > a_MemberFunction )
+		: m_Invocation( FunctorMember< Object > )
+		, m_Object( &a_ObjectInstance )
+		, m_Function( StoreLambda( a_MemberFunction ) )
+		, m_Manager( ManageLambda< MemberFunction< Object > > )
+	{ }
+
+	/// <summary>
+	/// 
+	/// </summary>
+	Invoker( StaticFunction a_StaticFunction )
+		: m_Invocation( FunctorStatic )
+		, m_Object( nullptr )
+		, m_Function( reinterpret_cast< void* >( a_StaticFunction ) )
+		, m_Manager( nullptr )
+	{ }
+
+#ifdef __cpp_nontype_template_parameter_auto
+	/// <summary>
+	/// Binds a member function fixed at compile time. The target is baked
+	/// into the thunk, so the call can be inlined. m_Function addresses a
+	/// constant holding it, only to compare and remove the subscriber like
+	/// one added with the member function pointer.
+	/// </summary>
+	template < auto Function, typename Object >
+	static Invoker Bind( Object& a_ObjectInstance )
+	{
+		Invoker Result;
+		Result.m_Object = &a_ObjectInstance;
+		Result.m_Function = const_cast< void* >( static_cast< const void* >( &BoundFunction< Function > ) );
+		Result.m_Invocation = BoundMember< Function, Object >;
+		Result.m_Manager = ManageConstant< decltype( Function ) >;
+		return Result;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < auto Function, typename Object >
+	static Invoker Bind( Object* a_ObjectInstance )
+	{
+		return Bind< Function >( *a_ObjectInstance );
+	}
+
+	/// <summary>
+	/// Binds a free function fixed at compile time. m_Function still holds
+	/// it so the invoker compares equal to the plain function.
+	/// </summary>
+	template < auto Function >
+	static Invoker Bind()
+	{
+		Invoker Result;
+		Result.m_Function = reinterpret_cast< void* >( Function );
+		Result.m_Invocation = BoundStatic< Function >;
+		return Result;
+	}
+#endif
+
+	/// <summary>
+	/// 
+	/// </summary>
+	~Invoker()
+	{
+		Reset();
+	}
+	
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline Return Invoke( Params&&... a_Params )
+	{
+		if ( !IsSet() )
+		{
+			return Return();
+		}
+
+		return m_Invocation( m_Object, m_Function, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Arguments are forwarded as the thunk expects them, so nothing is
+	/// copied on the way to the target and move only values can be passed.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline Return operator()( Params&&... a_Params ) const
+	{
+		if ( !IsSet() )
+		{
+			return Return();
+		}
+
+		return m_Invocation( m_Object, m_Function, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Owned lambdas are copied along with the invoker, so they compare by
+	/// their captures if those can be compared bytewise and by type alone
+	/// otherwise. Keep the DelegateHandle to tell such lambdas apart.
+	/// </summary>
+	inline bool operator==( const Invoker< Return, Args... >& a_Other ) const
+	{
+		return IsSame( a_Other, m_Invocation, m_Object, m_Function, m_Manager );
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	inline bool operator==( Lambda a_Lambda ) const
+	{
+		return m_Invocation == FunctorLambda< Lambda > && ManageLambda< Lambda >( LambdaOperation::Compare, &a_Lambda, m_Object );
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename Object, typename = FunctionTraits::DisableIfLambdaF< Object > >
+	inline bool operator==( const Object& a_Object ) const
+	{
+		return m_Object == &a_Object;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename Object, typename = FunctionTraits::DisableIfLambdaF< Object > >
+	inline bool operator==( const Object* a_Object ) const
+	{
+		return m_Object == a_Object;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename Object >
+	inline bool operator==( MemberFunction< Object > a_MemberFunction ) const
+	{
+		using Function = MemberFunction< Object >;
+
+		return ( m_Manager == ManageLambda< Function > || m_Manager == ManageConstant< Function > ) &&
+			   *static_cast< const Function* >( m_Function ) == a_MemberFunction;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline bool operator==( StaticFunction a_StaticFunction ) const
+	{
+		return m_Function == reinterpret_cast< void* >( a_StaticFunction );
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline bool operator!=( const Invoker< Return, Args... >& a_Other ) const
+	{
+		return !operator==( a_Other );
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline Invoker& operator=( const Invoker& a_Other )
+	{
+		if ( this != &a_Other )
+		{
+			Reset();
+			CopyFrom( a_Other );
+		}
+
+		return *this;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline Invoker& operator=( Invoker&& a_Other )
+	{
+		if ( this != &a_Other )
+		{
+			Reset();
+			MoveFrom( a_Other );
+		}
+
+		return *this;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	inline void operator=( Lambda a_Lambda )
+	{
+		Reset();
+		m_Object = StoreLambda( a_Lambda );
+		m_Function = nullptr;
+		m_Invocation = FunctorLambda< Lambda >;
+		m_Manager = ManageLambda< Lambda >;
+	}
+	
+	/// <summary>
+	/// 
+	/// </summary>
+	inline void operator=( StaticFunction a_StaticFunction )
+	{
+		Reset();
+		m_Object = nullptr;
+		m_Function = reinterpret_cast< void* >( a_StaticFunction );
+		m_Invocation = FunctorStatic;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline bool IsSet() const { return m_Invocation; }
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline bool IsLambda() const { return m_Manager && !m_Function; }
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline bool IsMember() const { return m_Object && m_Function; }
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline bool IsStatic() const { return !m_Object; }
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline void Reset()
+	{
+		if ( m_Manager )
+		{
+			m_Manager( LambdaOperation::Destroy, m_Buffer, GetOwned() );
+		}
+
+		m_Object = nullptr;
+		m_Function = nullptr;
+		m_Invocation = nullptr;
+		m_Manager = nullptr;
+	}
+
+private:
+
+	template < typename T >
+	using FitsBuffer = std::integral_constant< bool,
+		sizeof( T ) <= BufferSize &&
+		alignof( T ) <= alignof( void* ) &&
+		std::is_nothrow_move_constructible< T >::value >;
+
+	/// <summary>
+	/// Captures without padding or floating point members are equal exactly
+	/// when their bytes are.
+	/// </summary>
+#ifdef __cpp_lib_has_unique_object_representations
+	template < typename T >
+	using IsBytewiseComparable = std::has_unique_object_representations< T >;
+#else
+	template < typename T >
+	using IsBytewiseComparable = std::false_type;
+#endif
+
+	template < typename T >
+	static inline bool IsEqual( const T& a_Left, const T& a_Right )
+	{
+		return IsEqual( a_Left, a_Right, std::is_member_function_pointer< T >(), IsBytewiseComparable< T >() );
+	}
+
+	template < typename T, typename IsBytewise >
+	static inline bool IsEqual( const T& a_Left, const T& a_Right, std::true_type, IsBytewise )
+	{
+		return a_Left == a_Right;
+	}
+
+	template < typename T >
+	static inline bool IsEqual( const T& a_Left, const T& a_Right, std::false_type, std::true_type )
+	{
+		return std::memcmp( &a_Left, &a_Right, sizeof( T ) ) == 0;
+	}
+
+	template < typename T >
+	static inline bool IsEqual( const T&, const T&, std::false_type, std::false_type )
+	{
+		return true;
+	}
+
+	/// <summary>
+	/// State a manager owns: a lambda's captures, or the member function
+	/// pointer of a member subscriber, whose object is not owned.
+	/// </summary>
+	static inline void* GetOwned( void* a_Object, void* a_Function )
+	{
+		return a_Function ? a_Function : a_Object;
+	}
+
+	inline void*& GetOwned()
+	{
+		return m_Function ? m_Function : m_Object;
+	}
+
+	/// <summary>
+	/// Whether a stored subscriber, given by its parts, equals a_Invoker.
+	/// </summary>
+	static inline bool IsSame( const Invoker& a_Invoker, InvocationFunction a_Invocation, void* a_Object, void* a_Function, LambdaManager a_Manager )
+	{
+		if ( a_Invocation != a_Invoker.m_Invocation )
+		{
+			return false;
+		}
+
+		if ( !a_Manager )
+		{
+			return a_Object == a_Invoker.m_Object && a_Function == a_Invoker.m_Function;
+		}
+
+		return ( !a_Function || a_Object == a_Invoker.m_Object ) &&
+			   a_Manager( LambdaOperation::Compare, GetOwned( a_Invoker.m_Object, a_Invoker.m_Function ), GetOwned( a_Object, a_Function ) ) != nullptr;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename T >
+	inline void* StoreLambda( T& a_Lambda )
+	{
+		void* Storage = FitsBuffer< T >::value ? m_Buffer : LambdaPool::Allocate( sizeof( T ), alignof( T ) );
+		return new ( Storage ) T( std::move( a_Lambda ) );
+	}
+
+	/// <summary>
+	/// Copies, moves, destroys or compares a lambda of type T. a_Buffer is
+	/// the inline buffer of the invoker involved, a null buffer forces the
+	/// copy into the LambdaPool. Move is only requested for lambdas held
+	/// inline. Compare takes the other lambda in a_Buffer and returns
+	/// a_Lambda if the two are equal. Hash returns the key a member
+	/// function pointer is indexed by.
+	/// </summary>
+	template < typename T >
+	static void* ManageLambda( LambdaOperation a_Operation, void* a_Buffer, void* a_Lambda )
+	{
+		T* Lambda = static_cast< T* >( a_Lambda );
+
+		switch ( a_Operation )
+		{
+		case LambdaOperation::Copy:
+		{
+			void* Storage = a_Buffer && FitsBuffer< T >::value ? a_Buffer : LambdaPool::Allocate( sizeof( T ), alignof( T ) );
+			return new ( Storage ) T( *Lambda );
+		}
+		case LambdaOperation::Move:
+		{
+			T* Result = new ( a_Buffer ) T( std::move( *Lambda ) );
+			Lambda->~T();
+			return Result;
+		}
+		case LambdaOperation::Destroy:
+		{
+			Lambda->~T();
+
+			if ( a_Lambda != a_Buffer )
+			{
+				LambdaPool::Free( a_Lambda, sizeof( T ), alignof( T ) );
+			}
+
+			return nullptr;
+		}
+		case LambdaOperation::Compare:
+		{
+			return IsEqual( *static_cast< const T* >( a_Buffer ), *Lambda ) ? a_Lambda : nullptr;
+		}
+		case LambdaOperation::Hash:
+		{
+			return HashBytes( *Lambda );
+		}
+		}
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Folds the bytes of a_Value into a pointer sized key. Equal member
+	/// function pointers have equal bytes, so they share a chain of the
+	/// function index and every other pointer rarely does.
+	/// </summary>
+	template < typename T >
+	static inline void* HashBytes( const T& a_Value )
+	{
+		const unsigned char* Bytes = reinterpret_cast< const unsigned char* >( &a_Value );
+		uintptr_t Hash = sizeof( T );
+
+		for ( size_t i = 0; i < sizeof( T ); ++i )
+		{
+			Hash = Hash * 131 + Bytes[ i ];
+		}
+
+		return reinterpret_cast< void* >( Hash );
+	}
+
+	/// <summary>
+	/// Manager of a member function pointer in static storage, as kept by
+	/// bound invokers. It is shared rather than copied and only compared.
+	/// </summary>
+	template < typename T >
+	static void* ManageConstant( LambdaOperation a_Operation, void* a_Buffer, void* a_Lambda )
+	{
+		switch ( a_Operation )
+		{
+		case LambdaOperation::Compare:
+		case LambdaOperation::Hash:
+			return ManageLambda< T >( a_Operation, a_Buffer, a_Lambda );
+		case LambdaOperation::Destroy:
+			return nullptr;
+		default:
+			return a_Lambda;
+		}
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline void CopyFrom( const Invoker& a_Other )
+	{
+		m_Object = a_Other.m_Object;
+		m_Function = a_Other.m_Function;
+		m_Invocation = a_Other.m_Invocation;
+		m_Manager = a_Other.m_Manager;
+
+		if ( m_Manager )
+		{
+			void*& Owned = GetOwned();
+			Owned = m_Manager( LambdaOperation::Copy, m_Buffer, Owned );
+		}
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	inline void MoveFrom( Invoker& a_Other )
+	{
+		m_Object = a_Other.m_Object;
+		m_Function = a_Other.m_Function;
+		m_Invocation = a_Other.m_Invocation;
+		m_Manager = a_Other.m_Manager;
+
+		if ( m_Manager && a_Other.GetOwned() == a_Other.m_Buffer )
+		{
+			void*& Owned = GetOwned();
+			Owned = m_Manager( LambdaOperation::Move, m_Buffer, Owned );
+		}
+
+		a_Other.m_Object = nullptr;
+		a_Other.m_Function = nullptr;
+		a_Other.m_Invocation = nullptr;
+		a_Other.m_Manager = nullptr;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename T >
+	static inline Return FunctorLambda( void* a_LambdaInstance, void*, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		return ( reinterpret_cast< T* >( a_LambdaInstance )->T::operator() )( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < typename T >
+	static inline Return FunctorMember( void* a_ObjectInstance, void* a_MemberFunction, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		return ( reinterpret_cast< T* >( a_ObjectInstance )->**static_cast< MemberFunction< T >* >( a_MemberFunction ) )( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+#ifdef __cpp_nontype_template_parameter_auto
+	/// <summary>
+	/// 
+	/// </summary>
+	template < auto Function, typename Object >
+	static Return BoundMember( void* a_ObjectInstance, void*, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		return ( static_cast< Object* >( a_ObjectInstance )->*Function )( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	template < auto Function >
+	static Return BoundStatic( void*, void*, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		return Function( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	template < auto Function >
+	static constexpr decltype( Function ) BoundFunction = Function;
+#endif
+
+	/// <summary>
+	/// 
+	/// </summary>
+	static inline Return FunctorStatic( void*, void* a_StaticFunction, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		return reinterpret_cast< StaticFunction >( a_StaticFunction )( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	//==========================================================================
+	template < class, class...  > friend class Delegate;
+	template < class, class...  > friend class ConcurrentDelegate;
+	template < class T, class U > friend auto MakeInvoker( T*, U );
+	template < class T, class U > friend auto MakeInvoker( T&, U );
+	template < class T          > friend auto MakeInvoker( T     );
+
+	//==========================================================================
+	InvocationFunction m_Invocation;
+	void*			   m_Object;
+	void*			   m_Function;
+	LambdaManager      m_Manager;
+	alignas( void* )
+	unsigned char      m_Buffer[ BufferSize ];
+
+};
+
+//==========================================================================
+template < typename T >
+auto MakeInvoker( T a_Function )
+{
+	return typename FunctionTraits::ConvertToInvoker< T >::Type( a_Function );
+}
+
+//==========================================================================
+template < typename T, typename U >
+auto MakeInvoker( T* a_Object, U a_Member )
+{
+	return typename FunctionTraits::ConvertToInvoker< U >::Type( a_Object, a_Member );
+}
+
+//==========================================================================
+template < typename T, typename U >
+auto MakeInvoker( T& a_Object, U a_Member )
+{
+	return typename FunctionTraits::ConvertToInvoker< U >::Type( a_Object, a_Member );
+}
+
+#ifdef __cpp_nontype_template_parameter_auto
+//==========================================================================
+template < auto Function >
+auto MakeInvoker()
+{
+	return FunctionTraits::ConvertToInvoker< decltype( Function ) >::Type::template Bind< Function >();
+}
+
+//==========================================================================
+template < auto Function, typename T >
+auto MakeInvoker( T& a_Object )
+{
+	return FunctionTraits::ConvertToInvoker< decltype( Function ) >::Type::template Bind< Function >( a_Object );
+}
+
+//==========================================================================
+template < auto Function, typename T >
+auto MakeInvoker( T* a_Object )
+{
+	return FunctionTraits::ConvertToInvoker< decltype( Function ) >::Type::template Bind< Function >( *a_Object );
+}
+#endif
+
+#ifndef DELEGATE_THREAD_POOL_SIZE
+#define DELEGATE_THREAD_POOL_SIZE 0
+#endif
+
+//==========================================================================
+// Work stealing pool behind Delegate::InvokeAllParallel. Every worker owns
+// a deque, runs its own chunks from the back and steals from the front of
+// the other deques once it runs dry. The forking thread helps drain work
+// until its chunks are done, so a parallel broadcast raised from inside a
+// subscriber joins instead of deadlocking.
+//==========================================================================
+class DelegateThreadPool
+{
+public:
+
+	using TaskFunction = void( * )( void*, size_t, size_t );
+
+	/// <summary>
+	/// Process wide pool. DELEGATE_THREAD_POOL_SIZE sets the worker count,
+	/// zero uses one worker per hardware thread besides the caller.
+	/// </summary>
+	static DelegateThreadPool& Get()
+	{
+		static DelegateThreadPool s_Pool( DELEGATE_THREAD_POOL_SIZE ? DELEGATE_THREAD_POOL_SIZE : std::max( std::thread::hardware_concurrency(), 1u ) - 1 );
+		return s_Pool;
+	}
+
+	explicit DelegateThreadPool( size_t a_WorkerCount )
+		: m_Queued( 0 )
+		, m_Stop( false )
+	{
+		// One queue per worker plus a shared one for threads outside the pool.
+		for ( size_t i = 0; i <= a_WorkerCount; ++i )
+		{
+			m_Queues.emplace_back( new WorkQueue() );
+		}
+
+		for ( size_t i = 0; i < a_WorkerCount; ++i )
+		{
+			m_Workers.emplace_back( &DelegateThreadPool::WorkerMain, this, i );
+		}
+	}
+
+	DelegateThreadPool( const DelegateThreadPool& ) = delete;
+	DelegateThreadPool& operator=( const DelegateThreadPool& ) = delete;
+
+	~DelegateThreadPool()
+	{
+		{
+			std::lock_guard< std::mutex > Lock( m_SleepMutex );
+			m_Stop = true;
+		}
+
+		m_WakeUp.notify_all();
+
+		for ( size_t i = 0; i < m_Workers.size(); ++i )
+		{
+			m_Workers[ i ].join();
+		}
+	}
+
+	inline size_t GetWorkerCount() const { return m_Workers.size(); }
+
+	/// <summary>
+	/// Splits [0, a_Count) into chunks of a_ChunkSize, runs a_Function on
+	/// each of them across the pool and returns once all have completed.
+	/// </summary>
+	template < typename Function >
+	void ParallelFor( size_t a_Count, size_t a_ChunkSize, Function& a_Function )
+	{
+		ParallelFor( a_Count, a_ChunkSize, &RunChunk< Function >, &a_Function );
+	}
+
+	void ParallelFor( size_t a_Count, size_t a_ChunkSize, TaskFunction a_Function, void* a_Context )
+	{
+		if ( a_Count <= a_ChunkSize || m_Workers.empty() )
+		{
+			a_Function( a_Context, 0, a_Count );
+			return;
+		}
+
+		const size_t Chunks = ( a_Count + a_ChunkSize - 1 ) / a_ChunkSize;
+		const size_t Home = GetHomeQueue();
+		std::atomic< size_t > Pending( Chunks );
+
+		// Deal chunks round robin so every worker starts on its own share.
+		for ( size_t i = 0; i < Chunks; ++i )
+		{
+			WorkQueue& Queue = *m_Queues[ ( Home + i ) % m_Queues.size() ];
+			std::lock_guard< std::mutex > Lock( Queue.Mutex );
+			Queue.Tasks.push_back( { a_Function, a_Context, i * a_ChunkSize, std::min( a_Count, ( i + 1 ) * a_ChunkSize ), &Pending } );
+		}
+
+		m_Queued.fetch_add( Chunks, std::memory_order_release );
+
+		{
+			std::lock_guard< std::mutex > Lock( m_SleepMutex );
+		}
+
+		m_WakeUp.notify_all();
+
+		while ( Pending.load( std::memory_order_acquire ) != 0 )
+		{
+			Task Next;
+
+			if ( TryTake( Home, Next ) )
+			{
+				Run( Next );
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+private:
+
+	static constexpr size_t NoWorker = ~size_t( 0 );
+
+	struct Task
+	{
+		TaskFunction           Function;
+		void*                  Context;
+		size_t                 Begin;
+		size_t                 End;
+		std::atomic< size_t >* Pending;
+	};
+
+	struct WorkQueue
+	{
+		std::mutex         Mutex;
+		std::deque< Task > Tasks;
+	};
+
+	template < typename Function >
+	static void RunChunk( void* a_Context, size_t a_Begin, size_t a_End )
+	{
+		( *static_cast< Function* >( a_Context ) )( a_Begin, a_End );
+	}
+
+	static inline size_t& GetWorkerIndex()
+	{
+		thread_local size_t s_WorkerIndex = NoWorker;
+		return s_WorkerIndex;
+	}
+
+	inline size_t GetHomeQueue() const
+	{
+		const size_t Index = GetWorkerIndex();
+		return Index == NoWorker ? m_Workers.size() : Index;
+	}
+
+	static inline void Run( const Task& a_Task )
+	{
+		a_Task.Function( a_Task.Context, a_Task.Begin, a_Task.End );
+		a_Task.Pending->fetch_sub( 1, std::memory_order_release );
+	}
+
+	bool TryTake( size_t a_Home, Task& a_Task )
+	{
+		if ( !m_Queued.load( std::memory_order_acquire ) )
+		{
+			return false;
+		}
+
+		{
+			WorkQueue& Own = *m_Queues[ a_Home ];
+			std::lock_guard< std::mutex > Lock( Own.Mutex );
+
+			if ( !Own.Tasks.empty() )
+			{
+				a_Task = Own.Tasks.back();
+				Own.Tasks.pop_back();
+				m_Queued.fetch_sub( 1, std::memory_order_relaxed );
+				return true;
+			}
+		}
+
+		for ( size_t i = 1; i < m_Queues.size(); ++i )
+		{
+			WorkQueue& Victim = *m_Queues[ ( a_Home + i ) % m_Queues.size() ];
+			std::lock_guard< std::mutex > Lock( Victim.Mutex );
+
+			if ( !Victim.Tasks.empty() )
+			{
+				a_Task = Victim.Tasks.front();
+				Victim.Tasks.pop_front();
+				m_Queued.fetch_sub( 1, std::memory_order_relaxed );
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void WorkerMain( size_t a_Index )
+	{
+		GetWorkerIndex() = a_Index;
+
+		for ( ;; )
+		{
+			Task Next;
+
+			if ( TryTake( a_Index, Next ) )
+			{
+				Run( Next );
+				continue;
+			}
+
+			std::unique_lock< std::mutex > Lock( m_SleepMutex );
+			m_WakeUp.wait( Lock, [ this ]() { return m_Stop || m_Queued.load( std::memory_order_acquire ) != 0; } );
+
+			if ( m_Stop )
+			{
+				return;
+			}
+		}
+	}
+
+	std::vector< std::unique_ptr< WorkQueue > > m_Queues;
+	std::vector< std::thread >                  m_Workers;
+	std::atomic< size_t >                       m_Queued;
+	std::mutex                                  m_SleepMutex;
+	std::condition_variable                     m_WakeUp;
+	bool                                        m_Stop;
+
+};
+
+#ifndef DELEGATE_QUEUE_CAPACITY
+#define DELEGATE_QUEUE_CAPACITY 1024
+#endif
+
+//==========================================================================
+// Ring buffer behind Delegate::Enqueue. Storage is kept between flushes,
+// so once it has grown to the peak backlog a push only constructs the
+// event in place.
+//==========================================================================
+template < typename T >
+class EventRing
+{
+public:
+
+	EventRing()
+		: m_Slots( nullptr )
+		, m_Capacity( 0 )
+		, m_Head( 0 )
+		, m_Count( 0 )
+	{ }
+
+	EventRing( EventRing&& a_Other )
+		: EventRing()
+	{
+		Swap( a_Other );
+	}
+
+	EventRing( const EventRing& ) = delete;
+	EventRing& operator=( const EventRing& ) = delete;
+
+	EventRing& operator=( EventRing&& a_Other )
+	{
+		Clear();
+		Swap( a_Other );
+		return *this;
+	}
+
+	~EventRing()
+	{
+		Clear();
+		std::allocator< T >().deallocate( m_Slots, m_Capacity );
+	}
+
+	template < typename... Params >
+	inline void Push( Params&&... a_Params )
+	{
+		if ( m_Count == m_Capacity )
+		{
+			Reserve( m_Capacity ? m_Capacity * 2 : 16 );
+		}
+
+		::new( &m_Slots[ ( m_Head + m_Count ) & ( m_Capacity - 1 ) ] ) T( std::forward< Params >( a_Params )... );
+		++m_Count;
+	}
+
+	inline T& Front() { return m_Slots[ m_Head ]; }
+
+	inline void Pop()
+	{
+		m_Slots[ m_Head ].~T();
+		m_Head = ( m_Head + 1 ) & ( m_Capacity - 1 );
+		--m_Count;
+	}
+
+	inline size_t GetCount() const { return m_Count; }
+
+	inline void Clear()
+	{
+		while ( m_Count )
+		{
+			Pop();
+		}
+	}
+
+	/// <summary>
+	/// Rounds up to a power of two so wrapping is a mask.
+	/// </summary>
+	void Reserve( size_t a_Capacity )
+	{
+		size_t Capacity = 1;
+
+		while ( Capacity < a_Capacity )
+		{
+			Capacity *= 2;
+		}
+
+		if ( Capacity <= m_Capacity )
+		{
+			return;
+		}
+
+		T* Slots = std::allocator< T >().allocate( Capacity );
+
+		for ( size_t i = 0; i < m_Count; ++i )
+		{
+			T& Current = m_Slots[ ( m_Head + i ) & ( m_Capacity - 1 ) ];
+			::new( &Slots[ i ] ) T( std::move( Current ) );
+			Current.~T();
+		}
+
+		std::allocator< T >().deallocate( m_Slots, m_Capacity );
+		m_Slots = Slots;
+		m_Capacity = Capacity;
+		m_Head = 0;
+	}
+
+	inline void Swap( EventRing& a_Other )
+	{
+		std::swap( m_Slots, a_Other.m_Slots );
+		std::swap( m_Capacity, a_Other.m_Capacity );
+		std::swap( m_Head, a_Other.m_Head );
+		std::swap( m_Count, a_Other.m_Count );
+	}
+
+private:
+
+	T*     m_Slots;
+	size_t m_Capacity;
+	size_t m_Head;
+	size_t m_Count;
+
+};
+
+//==========================================================================
+// Bounded lock free ring for any number of producers and one consumer.
+// Each cell carries a sequence number telling whose turn it is: a
+// producer claims a position by advancing the tail and publishes the
+// event by bumping the cell's sequence, the consumer releases the cell
+// for the next lap the same way.
+//==========================================================================
+template < typename T >
+class MpscEventRing
+{
+public:
+
+	MpscEventRing( size_t a_Capacity )
+		: m_Capacity( 1 )
+		, m_Head( 0 )
+		, m_Tail( 0 )
+	{
+		while ( m_Capacity < a_Capacity )
+		{
+			m_Capacity *= 2;
+		}
+
+		m_Cells.reset( new Cell[ m_Capacity ] );
+
+		for ( size_t i = 0; i < m_Capacity; ++i )
+		{
+			m_Cells[ i ].Sequence.store( i, std::memory_order_relaxed );
+		}
+	}
+
+	MpscEventRing( const MpscEventRing& ) = delete;
+	MpscEventRing& operator=( const MpscEventRing& ) = delete;
+
+	~MpscEventRing()
+	{
+		while ( Peek() )
+		{
+			Pop();
+		}
+	}
+
+	/// <summary>
+	/// Returns false without blocking when the ring is full.
+	/// </summary>
+	template < typename... Params >
+	bool TryPush( Params&&... a_Params )
+	{
+		size_t Position = m_Tail.load( std::memory_order_relaxed );
+		Cell* Current;
+
+		for ( ;; )
+		{
+			Current = &m_Cells[ Position & ( m_Capacity - 1 ) ];
+			const size_t Sequence = Current->Sequence.load( std::memory_order_acquire );
+			const ptrdiff_t Difference = static_cast< ptrdiff_t >( Sequence - Position );
+
+			if ( Difference == 0 )
+			{
+				if ( m_Tail.compare_exchange_weak( Position, Position + 1, std::memory_order_relaxed ) )
+				{
+					break;
+				}
+			}
+			else if ( Difference < 0 )
+			{
+				return false;
+			}
+			else
+			{
+				Position = m_Tail.load( std::memory_order_relaxed );
+			}
+		}
+
+		::new( &Current->Storage ) T( std::forward< Params >( a_Params )... );
+		Current->Sequence.store( Position + 1, std::memory_order_release );
+		return true;
+	}
+
+	/// <summary>
+	/// Consumer only. Returns the oldest event, or null if it has not been
+	/// published yet.
+	/// </summary>
+	inline T* Peek()
+	{
+		Cell& Current = m_Cells[ m_Head & ( m_Capacity - 1 ) ];
+
+		if ( Current.Sequence.load( std::memory_order_acquire ) != m_Head + 1 )
+		{
+			return nullptr;
+		}
+
+		return reinterpret_cast< T* >( &Current.Storage );
+	}
+
+	/// <summary>
+	/// Consumer only, after a successful Peek.
+	/// </summary>
+	inline void Pop()
+	{
+		Cell& Current = m_Cells[ m_Head & ( m_Capacity - 1 ) ];
+		reinterpret_cast< T* >( &Current.Storage )->~T();
+		Current.Sequence.store( m_Head + m_Capacity, std::memory_order_release );
+		++m_Head;
+	}
+
+	/// <summary>
+	/// Position the next producer will claim, a bound for draining what
+	/// was queued up to now.
+	/// </summary>
+	inline size_t GetTail() const { return m_Tail.load( std::memory_order_acquire ); }
+
+	inline size_t GetHead() const { return m_Head; }
+
+private:
+
+	struct Cell
+	{
+		std::atomic< size_t > Sequence;
+		typename std::aligned_storage< sizeof( T ), alignof( T ) >::type Storage;
+	};
+
+	std::unique_ptr< Cell[] > m_Cells;
+	size_t                    m_Capacity;
+	size_t                    m_Head;
+
+	// Keeps the producers' tail off the consumer's cache line.
+	char                      m_Padding[ 64 ];
+	std::atomic< size_t >     m_Tail;
+
+};
+
+//==========================================================================
+// Inbox of a thread that subscribers can be bound to. Delegates hand it
+// the calls meant for that thread through a lock free intrusive stack,
+// one post per broadcast however many of its subscribers were hit, and
+// the thread runs them when it calls Pump. It must outlive the
+// subscribers bound to it.
+//==========================================================================
+class DelegateExecutor
+{
+public:
+
+	explicit DelegateExecutor( std::thread::id a_Owner = std::this_thread::get_id() )
+		: m_Owner( a_Owner )
+		, m_Inbox( nullptr )
+	{ }
+
+	DelegateExecutor( const DelegateExecutor& ) = delete;
+	DelegateExecutor& operator=( const DelegateExecutor& ) = delete;
+
+	/// <summary>
+	/// Posts that were never pumped are dropped without running.
+	/// </summary>
+	~DelegateExecutor()
+	{
+		Task* Current = m_Inbox.exchange( nullptr, std::memory_order_acquire );
+
+		while ( Current )
+		{
+			Task* Next = Current->Next;
+			Current->Run( Current, false );
+			Current = Next;
+		}
+	}
+
+	inline std::thread::id GetOwner() const { return m_Owner; }
+
+	inline bool IsCurrent() const { return std::this_thread::get_id() == m_Owner; }
+
+	inline bool IsEmpty() const { return m_Inbox.load( std::memory_order_relaxed ) == nullptr; }
+
+	/// <summary>
+	/// Runs everything posted so far, oldest first, and returns the number
+	/// of posts. Meant to be called on the owner thread. Posts made while
+	/// pumping wait for the next Pump.
+	/// </summary>
+	size_t Pump()
+	{
+		Task* Current = m_Inbox.exchange( nullptr, std::memory_order_acquire );
+		Task* Ordered = nullptr;
+
+		// The inbox is a stack, turn it around to run posts in order.
+		while ( Current )
+		{
+			Task* Next = Current->Next;
+			Current->Next = Ordered;
+			Ordered = Current;
+			Current = Next;
+		}
+
+		size_t Count = 0;
+
+		while ( Ordered )
+		{
+			Task* Next = Ordered->Next;
+			Ordered->Run( Ordered, true );
+			Ordered = Next;
+			++Count;
+		}
+
+		return Count;
+	}
+
+private:
+
+	/// <summary>
+	/// Intrusive post. Run executes it when asked to and always frees it.
+	/// </summary>
+	struct Task
+	{
+		using RunFunction = void( * )( Task*, bool );
+
+		explicit Task( RunFunction a_Run )
+			: Next( nullptr )
+			, Run( a_Run )
+		{ }
+
+		Task*       Next;
+		RunFunction Run;
+	};
+
+	inline void Post( Task* a_Task )
+	{
+		Task* Head = m_Inbox.load( std::memory_order_relaxed );
+
+		do
+		{
+			a_Task->Next = Head;
+		}
+		while ( !m_Inbox.compare_exchange_weak( Head, a_Task, std::memory_order_release, std::memory_order_relaxed ) );
+	}
+
+	template < class, class... > friend class Delegate;
+
+	const std::thread::id m_Owner;
+	std::atomic< Task* >  m_Inbox;
+
+};
+
+//==========================================================================
+// Secondary index from a key to the handle slots subscribed under it. Each
+// key heads an intrusive doubly linked chain through per slot links, so
+// linking and unlinking a slot is O(1) and visiting a key's subscribers
+// costs only the number of matches.
+//==========================================================================
+template < typename Key, typename Allocator = std::allocator< Key > >
+class SubscriberIndex
+{
+public:
+
+	static constexpr uint32_t NoSlot = ~0u;
+
+	void Link( Key a_Key, uint32_t a_Slot )
+	{
+		if ( a_Slot >= m_Links.size() )
+		{
+			m_Links.resize( a_Slot + 1, { NoSlot, NoSlot } );
+		}
+
+		// A local copy, emplace binding the constant itself would odr-use it before C++17.
+		const uint32_t Empty = NoSlot;
+		uint32_t& Head = m_Heads.emplace( a_Key, Empty ).first->second;
+
+		m_Links[ a_Slot ] = { NoSlot, Head };
+
+		if ( Head != NoSlot )
+		{
+			m_Links[ Head ].Previous = a_Slot;
+		}
+
+		Head = a_Slot;
+	}
+
+	void Unlink( Key a_Key, uint32_t a_Slot )
+	{
+		const Links Current = m_Links[ a_Slot ];
+
+		if ( Current.Next != NoSlot )
+		{
+			m_Links[ Current.Next ].Previous = Current.Previous;
+		}
+
+		if ( Current.Previous != NoSlot )
+		{
+			m_Links[ Current.Previous ].Next = Current.Next;
+		}
+		else if ( Current.Next != NoSlot )
+		{
+			m_Heads[ a_Key ] = Current.Next;
+		}
+		else
+		{
+			m_Heads.erase( a_Key );
+		}
+	}
+
+	inline uint32_t GetFirst( Key a_Key ) const
+	{
+		const auto Found = m_Heads.find( a_Key );
+		return Found == m_Heads.end() ? NoSlot : Found->second;
+	}
+
+	inline uint32_t GetNext( uint32_t a_Slot ) const { return m_Links[ a_Slot ].Next; }
+
+	inline void Clear()
+	{
+		m_Heads.clear();
+		m_Links.clear();
+	}
+
+private:
+
+	struct Links
+	{
+		uint32_t Previous;
+		uint32_t Next;
+	};
+
+	using HeadAllocator = typename std::allocator_traits< Allocator >::template rebind_alloc< std::pair< const Key, uint32_t > >;
+	using LinkAllocator = typename std::allocator_traits< Allocator >::template rebind_alloc< Links >;
+
+	std::unordered_map< Key, uint32_t, std::hash< Key >, std::equal_to< Key >, HeadAllocator > m_Heads;
+	std::vector< Links, LinkAllocator >                                                        m_Links;
+
+};
+
+//==========================================================================
+// Generational handle into a Delegate's slot table. A handle whose
+// subscriber was removed fails the generation check instead of resolving
+// to another subscriber or freed storage.
+//==========================================================================
+class DelegateHandle
+{
+public:
+
+	DelegateHandle()
+		: m_Index( 0 )
+		, m_Generation( 0 )
+	{ }
+
+	inline bool IsValid() const { return m_Generation != 0; }
+
+	inline bool operator==( const DelegateHandle& a_Other ) const
+	{
+		return m_Index == a_Other.m_Index && m_Generation == a_Other.m_Generation;
+	}
+
+	inline bool operator!=( const DelegateHandle& a_Other ) const
+	{
+		return !operator==( a_Other );
+	}
+
+private:
+
+	DelegateHandle( uint32_t a_Index, uint32_t a_Generation )
+		: m_Index( a_Index )
+		, m_Generation( a_Generation )
+	{ }
+
+	template < class, class... > friend class Delegate;
+	template < class, class... > friend class ConcurrentDelegate;
+
+	uint32_t m_Index;
+	uint32_t m_Generation;
+
+};
+
+//==========================================================================
+// Move only owner of one subscription, returned by Delegate::Connect.
+// Destroying or disconnecting it removes the subscriber through its handle
+// in O(1), also while the delegate is invoking. Live connections are
+// linked into their delegate, which detaches them if it goes first.
+//==========================================================================
+class ScopedConnection
+{
+public:
+
+	ScopedConnection()
+		: m_Delegate( nullptr )
+		, m_Remove( nullptr )
+		, m_Head( nullptr )
+		, m_Previous( nullptr )
+		, m_Next( nullptr )
+	{ }
+
+	ScopedConnection( ScopedConnection&& a_Other ) noexcept
+		: ScopedConnection()
+	{
+		TakeOver( a_Other );
+	}
+
+	ScopedConnection& operator=( ScopedConnection&& a_Other ) noexcept
+	{
+		if ( this != &a_Other )
+		{
+			Disconnect();
+			TakeOver( a_Other );
+		}
+
+		return *this;
+	}
+
+	ScopedConnection( const ScopedConnection& ) = delete;
+	ScopedConnection& operator=( const ScopedConnection& ) = delete;
+
+	~ScopedConnection()
+	{
+		Disconnect();
+	}
+
+	inline bool IsConnected() const { return m_Delegate != nullptr; }
+
+	inline DelegateHandle GetHandle() const { return m_Handle; }
+
+	/// <summary>
+	/// Removes the subscriber. Does nothing once disconnected.
+	/// </summary>
+	void Disconnect()
+	{
+		if ( m_Delegate )
+		{
+			void* Delegate = m_Delegate;
+			Unlink();
+			m_Remove( Delegate, m_Handle );
+		}
+	}
+
+	/// <summary>
+	/// Gives up ownership and returns the handle, the subscriber stays.
+	/// </summary>
+	DelegateHandle Release()
+	{
+		Unlink();
+		return m_Handle;
+	}
+
+private:
+
+	using RemoveFunction = void( * )( void*, DelegateHandle );
+
+	ScopedConnection( void* a_Delegate, RemoveFunction a_Remove, ScopedConnection** a_Head, DelegateHandle a_Handle )
+		: m_Delegate( a_Delegate )
+		, m_Remove( a_Remove )
+		, m_Handle( a_Handle )
+		, m_Head( a_Head )
+		, m_Previous( nullptr )
+		, m_Next( *a_Head )
+	{
+		if ( m_Next )
+		{
+			m_Next->m_Previous = this;
+		}
+
+		*m_Head = this;
+	}
+
+	void Unlink()
+	{
+		if ( !m_Delegate )
+		{
+			return;
+		}
+
+		if ( m_Previous )
+		{
+			m_Previous->m_Next = m_Next;
+		}
+		else
+		{
+			*m_Head = m_Next;
+		}
+
+		if ( m_Next )
+		{
+			m_Next->m_Previous = m_Previous;
+		}
+
+		m_Delegate = nullptr;
+		m_Head = nullptr;
+		m_Previous = nullptr;
+		m_Next = nullptr;
+	}
+
+	/// <summary>
+	/// Steps into a_Other's place in its delegate's list.
+	/// </summary>
+	void TakeOver( ScopedConnection& a_Other )
+	{
+		if ( !a_Other.m_Delegate )
+		{
+			m_Handle = a_Other.m_Handle;
+			return;
+		}
+
+		m_Delegate = a_Other.m_Delegate;
+		m_Remove   = a_Other.m_Remove;
+		m_Handle   = a_Other.m_Handle;
+		m_Head     = a_Other.m_Head;
+		m_Previous = a_Other.m_Previous;
+		m_Next     = a_Other.m_Next;
+
+		if ( m_Previous )
+		{
+			m_Previous->m_Next = this;
+		}
+		else
+		{
+			*m_Head = this;
+		}
+
+		if ( m_Next )
+		{
+			m_Next->m_Previous = this;
+		}
+
+		a_Other.m_Delegate = nullptr;
+		a_Other.m_Head = nullptr;
+		a_Other.m_Previous = nullptr;
+		a_Other.m_Next = nullptr;
+	}
+
+	template < class, class... > friend class Delegate;
+
+	void*              m_Delegate;
+	RemoveFunction     m_Remove;
+	DelegateHandle     m_Handle;
+	ScopedConnection** m_Head;
+	ScopedConnection*  m_Previous;
+	ScopedConnection*  m_Next;
+
+};
+
+//==========================================================================
+// Owns any number of connections, to delegates of any signature, and
+// disconnects them together.
+//==========================================================================
+class ScopedConnectionGroup
+{
+public:
+
+	ScopedConnectionGroup() = default;
+	ScopedConnectionGroup( ScopedConnectionGroup&& ) = default;
+
+	ScopedConnectionGroup& operator=( ScopedConnectionGroup&& a_Other )
+	{
+		if ( this != &a_Other )
+		{
+			DisconnectAll();
+			m_Connections = std::move( a_Other.m_Connections );
+		}
+
+		return *this;
+	}
+
+	~ScopedConnectionGroup()
+	{
+		DisconnectAll();
+	}
+
+	inline void Add( ScopedConnection&& a_Connection )
+	{
+		m_Connections.push_back( std::move( a_Connection ) );
+	}
+
+	inline ScopedConnectionGroup& operator+=( ScopedConnection&& a_Connection )
+	{
+		Add( std::move( a_Connection ) );
+		return *this;
+	}
+
+	inline void Reserve( size_t a_Capacity ) { m_Connections.reserve( a_Capacity ); }
+
+	inline size_t GetCount() const { return m_Connections.size(); }
+
+	void DisconnectAll()
+	{
+		for ( size_t i = 0; i < m_Connections.size(); ++i )
+		{
+			m_Connections[ i ].Disconnect();
+		}
+
+		m_Connections.clear();
+	}
+
+private:
+
+	std::vector< ScopedConnection > m_Connections;
+
+};
+
+//==========================================================================
+// Content filter for Delegate::Add. The subscriber only sees broadcasts
+// whose argument at Index, projected through Projection, equals Key. The
+// projection is the argument itself, a data member or a const getter of
+// the argument or of what it points to. Keys are integers, enums or
+// pointers.
+//==========================================================================
+struct DelegateKeyIdentity { };
+
+inline bool operator==( DelegateKeyIdentity, DelegateKeyIdentity ) { return true; }
+
+template < size_t Index, typename Key, typename Projection = DelegateKeyIdentity >
+struct DelegateFilter
+{
+	Projection Project;
+	Key        Value;
+};
+
+template < typename Projection >
+struct DelegateProjection;
+
+template <>
+struct DelegateProjection< DelegateKeyIdentity >
+{
+	template < typename Arg >
+	static inline const Arg& Apply( const Arg& a_Argument, DelegateKeyIdentity )
+	{
+		return a_Argument;
+	}
+};
+
+template < typename Class, typename Member >
+struct DelegateProjection< Member Class::* >
+{
+	static inline const Member& Apply( const Class& a_Argument, Member Class::* a_Member ) { return a_Argument.*a_Member; }
+	static inline const Member& Apply( const Class* a_Argument, Member Class::* a_Member ) { return a_Argument->*a_Member; }
+};
+
+template < typename Class, typename Result >
+struct DelegateProjection< Result( Class::* )() const >
+{
+	static inline Result Apply( const Class& a_Argument, Result( Class::* a_Getter )() const ) { return ( a_Argument.*a_Getter )(); }
+	static inline Result Apply( const Class* a_Argument, Result( Class::* a_Getter )() const ) { return ( a_Argument->*a_Getter )(); }
+};
+
+//==========================================================================
+template < size_t Index, typename Key >
+DelegateFilter< Index, Key > MakeFilter( Key a_Key )
+{
+	return { DelegateKeyIdentity(), a_Key };
+}
+
+//==========================================================================
+template < size_t Index, typename Projection, typename Key >
+DelegateFilter< Index, Key, Projection > MakeFilter( Projection a_Projection, Key a_Key )
+{
+	return { a_Projection, a_Key };
+}
+
+//==========================================================================
+// Bulk evaluation of the filters of up to 64 subscribers. Subscriber i
+// matches when it is not filtered or Keys[ i ] equals Key. Returns the
+// matches as a bit per subscriber, comparing four keys and sixteen
+// flags at a time where SSE2 or AVX2 is available.
+//==========================================================================
+inline uint64_t MatchFilterKeys( const uint64_t* a_Keys, const uint8_t* a_IsFiltered, size_t a_Count, uint64_t a_Key )
+{
+	uint64_t Result = 0;
+	size_t i = 0;
+
+#if defined( __AVX2__ )
+	const __m256i Key = _mm256_set1_epi64x( static_cast< long long >( a_Key ) );
+
+	for ( ; i + 4 <= a_Count; i += 4 )
+	{
+		const __m256i Keys = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( a_Keys + i ) );
+		const __m256i Equal = _mm256_cmpeq_epi64( Keys, Key );
+		Result |= static_cast< uint64_t >( _mm256_movemask_pd( _mm256_castsi256_pd( Equal ) ) ) << i;
+	}
+#elif defined( DELEGATE_HAS_SSE2 )
+	const __m128i Key = _mm_set1_epi64x( static_cast< long long >( a_Key ) );
+
+	for ( ; i + 4 <= a_Count; i += 4 )
+	{
+		const __m128 First = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_loadu_si128( reinterpret_cast< const __m128i* >( a_Keys + i ) ), Key ) );
+		const __m128 Second = _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_loadu_si128( reinterpret_cast< const __m128i* >( a_Keys + i + 2 ) ), Key ) );
+
+		// SSE2 has no 64 bit compare, a key matches when both of its halves do.
+		const __m128 Low = _mm_shuffle_ps( First, Second, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		const __m128 High = _mm_shuffle_ps( First, Second, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		Result |= static_cast< uint64_t >( _mm_movemask_ps( _mm_and_ps( Low, High ) ) ) << i;
+	}
+#endif
+
+	for ( ; i < a_Count; ++i )
+	{
+		Result |= static_cast< uint64_t >( a_Keys[ i ] == a_Key ) << i;
+	}
+
+	i = 0;
+
+#if defined( DELEGATE_HAS_SSE2 )
+	for ( ; i + 16 <= a_Count; i += 16 )
+	{
+		const __m128i Flags = _mm_loadu_si128( reinterpret_cast< const __m128i* >( a_IsFiltered + i ) );
+		Result |= static_cast< uint64_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( Flags, _mm_setzero_si128() ) ) ) << i;
+	}
+#endif
+
+	for ( ; i < a_Count; ++i )
+	{
+		Result |= static_cast< uint64_t >( a_IsFiltered[ i ] == 0 ) << i;
+	}
+
+	return Result;
+}
+
+inline size_t CountTrailingZeros( uint64_t a_Value )
+{
+#if defined( _MSC_VER )
+	unsigned long Index;
+	_BitScanForward64( &Index, a_Value );
+	return Index;
+#else
+	return static_cast< size_t >( __builtin_ctzll( a_Value ) );
+#endif
+}
+
+//==========================================================================
+// Stock result combiners for InvokeAll. A combiner is called with each
+// result as it is produced and returns false to stop the broadcast.
+//==========================================================================
+namespace Combiners
+{
+	/// <summary>
+	/// Stops at the first subscriber returning true, such as a handler that
+	/// consumed an input event.
+	/// </summary>
+	struct AnyTrue
+	{
+		template < typename T >
+		inline bool operator()( const T& a_Value )
+		{
+			Result = static_cast< bool >( a_Value );
+			return !Result;
+		}
+
+		bool Result = false;
+	};
+
+	/// <summary>
+	/// Stops at the first subscriber returning false.
+	/// </summary>
+	struct AllTrue
+	{
+		template < typename T >
+		inline bool operator()( const T& a_Value )
+		{
+			Result = static_cast< bool >( a_Value );
+			return Result;
+		}
+
+		bool Result = true;
+	};
+
+	/// <summary>
+	/// Adds up every result, starting from a value initialised T.
+	/// </summary>
+	template < typename T >
+	struct Sum
+	{
+		template < typename U >
+		inline bool operator()( U&& a_Value )
+		{
+			Result += std::forward< U >( a_Value );
+			return true;
+		}
+
+		T Result = T();
+	};
+
+	/// <summary>
+	/// HasResult stays false when there were no subscribers.
+	/// </summary>
+	template < typename T, typename Compare = std::less< T > >
+	struct Max
+	{
+		template < typename U >
+		inline bool operator()( U&& a_Value )
+		{
+			if ( !HasResult || Compare()( Result, a_Value ) )
+			{
+				Result = std::forward< U >( a_Value );
+				HasResult = true;
+			}
+
+			return true;
+		}
+
+		T Result = T();
+		bool HasResult = false;
+	};
+
+	template < typename T >
+	using Min = Max< T, std::greater< T > >;
+
+	/// <summary>
+	/// Keeps the first result that converts to true, like a non null pointer,
+	/// and skips the remaining subscribers.
+	/// </summary>
+	template < typename T >
+	struct FirstNonNull
+	{
+		template < typename U >
+		inline bool operator()( U&& a_Value )
+		{
+			if ( !a_Value )
+			{
+				return true;
+			}
+
+			Result = std::forward< U >( a_Value );
+			return false;
+		}
+
+		T Result = T();
+	};
+}
+
+//==========================================================================
+// Ordering contract of a Delegate. An Unordered delegate may regroup its
+// subscribers by invocation thunk and target, so a broadcast calls each
+// group back to back and the indirect calls stay predictable.
+//==========================================================================
+enum class DelegateOrdering
+{
+	Ordered,
+	Unordered
+};
+
+//==========================================================================
+// Log linear latency histogram in the spirit of HdrHistogram. Values below
+// SubBuckets nanoseconds are exact, above that every power of two is split
+// into SubBuckets buckets, which bounds the error to 1 / SubBuckets.
+//==========================================================================
+class LatencyHistogram
+{
+public:
+
+	static constexpr uint32_t SubBucketBits = 3;
+	static constexpr uint64_t SubBuckets    = uint64_t( 1 ) << SubBucketBits;
+	static constexpr uint32_t MaxBit        = 40;
+	static constexpr size_t   BucketCount   = ( MaxBit - SubBucketBits + 2 ) * SubBuckets;
+
+	LatencyHistogram()
+	{
+		Reset();
+	}
+
+	inline void Record( uint64_t a_Nanoseconds )
+	{
+		++m_Counts[ GetBucket( a_Nanoseconds ) ];
+		++m_Count;
+		m_Total += a_Nanoseconds;
+		m_Max = a_Nanoseconds > m_Max ? a_Nanoseconds : m_Max;
+	}
+
+	inline void Reset()
+	{
+		std::fill( m_Counts, m_Counts + BucketCount, 0 );
+		m_Count = 0;
+		m_Total = 0;
+		m_Max = 0;
+	}
+
+	inline uint64_t GetCount() const { return m_Count; }
+	inline uint64_t GetTotal() const { return m_Total; }
+	inline uint64_t GetMax() const { return m_Max; }
+
+	/// <summary>
+	/// Upper bound of the bucket holding the a_Percentile'th value, a_Percentile
+	/// being in [0, 100].
+	/// </summary>
+	uint64_t GetPercentile( double a_Percentile ) const
+	{
+		const uint64_t Target = static_cast< uint64_t >( a_Percentile / 100.0 * static_cast< double >( m_Count ) + 0.5 );
+		uint64_t Seen = 0;
+
+		for ( size_t i = 0; i < BucketCount; ++i )
+		{
+			Seen += m_Counts[ i ];
+
+			if ( Seen >= Target && Seen )
+			{
+				// The last bucket also holds everything beyond MaxBit.
+				const uint64_t Bound = i + 1 < BucketCount ? GetUpperBound( i ) : m_Max;
+				return Bound < m_Max ? Bound : m_Max;
+			}
+		}
+
+		return m_Max;
+	}
+
+private:
+
+	static inline uint32_t GetHighestBit( uint64_t a_Value )
+	{
+#if defined( __GNUC__ )
+		return 63 - static_cast< uint32_t >( __builtin_clzll( a_Value ) );
+#else
+		uint32_t Bit = 0;
+
+		while ( a_Value >>= 1 )
+		{
+			++Bit;
+		}
+
+		return Bit;
+#endif
+	}
+
+	static inline size_t GetBucket( uint64_t a_Value )
+	{
+		if ( a_Value < SubBuckets )
+		{
+			return static_cast< size_t >( a_Value );
+		}
+
+		const uint32_t Bit = GetHighestBit( a_Value );
+
+		if ( Bit > MaxBit )
+		{
+			return BucketCount - 1;
+		}
+
+		const uint32_t Shift = Bit - SubBucketBits;
+		return static_cast< size_t >( ( Shift + 1 ) * SubBuckets + ( ( a_Value >> Shift ) & ( SubBuckets - 1 ) ) );
+	}
+
+	static inline uint64_t GetUpperBound( size_t a_Bucket )
+	{
+		if ( a_Bucket < SubBuckets )
+		{
+			return a_Bucket;
+		}
+
+		const uint64_t Shift = a_Bucket / SubBuckets - 1;
+		return ( ( SubBuckets + a_Bucket % SubBuckets + 1 ) << Shift ) - 1;
+	}
+
+	uint32_t m_Counts[ BucketCount ];
+	uint64_t m_Count;
+	uint64_t m_Total;
+	uint64_t m_Max;
+
+};
+
+/// <summary>
+/// One subscriber's entry in Delegate::GetStatistics.
+/// </summary>
+struct SubscriberStatistics
+{
+	DelegateHandle Handle;
+	uint64_t       Calls;
+	uint64_t       TotalNanoseconds;
+	uint64_t       MaxNanoseconds;
+	uint64_t       P50Nanoseconds;
+	uint64_t       P99Nanoseconds;
+	uint64_t       P999Nanoseconds;
+};
+
+//==========================================================================
+// Instrumentation policies. A Delegate privately inherits its policy's
+// Table, indexed by handle slot so it stays off the arrays walked during
+// dispatch, and wraps every subscriber call in the policy's Scope.
+// NullInstrumentation is empty throughout and compiles away entirely.
+//==========================================================================
+struct NullInstrumentation
+{
+	struct Table
+	{
+		inline void ResetSlot( size_t ) { }
+		inline const LatencyHistogram* FindSlot( size_t ) const { return nullptr; }
+	};
+
+	struct Scope
+	{
+		inline Scope( Table&, size_t ) { }
+	};
+};
+
+/// <summary>
+/// Counts calls and records their latency per subscriber.
+/// </summary>
+struct LatencyInstrumentation
+{
+	class Table
+	{
+	public:
+
+		inline void ResetSlot( size_t a_Slot )
+		{
+			if ( a_Slot >= m_Histograms.size() )
+			{
+				m_Histograms.resize( a_Slot + 1 );
+			}
+
+			m_Histograms[ a_Slot ].Reset();
+		}
+
+		inline const LatencyHistogram* FindSlot( size_t a_Slot ) const
+		{
+			return a_Slot < m_Histograms.size() ? &m_Histograms[ a_Slot ] : nullptr;
+		}
+
+	private:
+
+		std::vector< LatencyHistogram > m_Histograms;
+
+		friend struct LatencyInstrumentation;
+	};
+
+	class Scope
+	{
+	public:
+
+		inline Scope( Table& a_Table, size_t a_Slot )
+			: m_Histogram( a_Table.m_Histograms[ a_Slot ] )
+			, m_Start( std::chrono::steady_clock::now() )
+		{ }
+
+		inline ~Scope()
+		{
+			m_Histogram.Record( static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - m_Start ).count() ) );
+		}
+
+	private:
+
+		LatencyHistogram&                     m_Histogram;
+		std::chrono::steady_clock::time_point m_Start;
+	};
+};
+
+#ifndef DELEGATE_INSTRUMENTATION
+#define DELEGATE_INSTRUMENTATION NullInstrumentation
+#endif
+
+/// <summary>
+/// Selects the instrumentation policy of every Delegate with the given
+/// signature. Specialize to instrument one kind of delegate, or define
+/// DELEGATE_INSTRUMENTATION to change the default for all of them.
+/// </summary>
+template < typename Signature >
+struct DelegateInstrumentation
+{
+	using Type = DELEGATE_INSTRUMENTATION;
+};
+
+#ifndef DELEGATE_ALLOCATOR
+#define DELEGATE_ALLOCATOR std::allocator
+#endif
+
+/// <summary>
+/// Selects the allocator template behind the storage of every Delegate
+/// with the given signature. Specialize with DelegatePoolAllocator to keep
+/// one kind of delegate off the heap, or define DELEGATE_ALLOCATOR to
+/// change the default for all of them. Allocators are default constructed.
+/// </summary>
+template < typename Signature >
+struct DelegateAllocator
+{
+	template < typename T >
+	using Type = DELEGATE_ALLOCATOR< T >;
+};
+
+//==========================================================================
+//
+//==========================================================================
+template < typename Return = void, typename... Args >
+class Delegate
+	: private DelegateInstrumentation< Return( Args... ) >::Type::Table
+{
+public:
+
+	using InvokerType        = Invoker< Return, Args... >;
+	using DelegateType       = Delegate< Return, Args... >;
+	using InvocationFunction = typename InvokerType::InvocationFunction;
+	using LambdaManager      = typename InvokerType::LambdaManager;
+	using QueuedEvent        = std::tuple< std::decay_t< Args >... >;
+	using Instrumentation    = typename DelegateInstrumentation< Return( Args... ) >::Type;
+
+	template < typename T >
+	using StorageAllocator = typename DelegateAllocator< Return( Args... ) >::template Type< T >;
+
+	template < typename T >
+	using StorageVector = std::vector< T, StorageAllocator< T > >;
+
+	template < typename Key >
+	using StorageIndex = SubscriberIndex< Key, StorageAllocator< Key > >;
+	
+	template < typename Object >
+	using MemberFunction = Return( Object::* )( Args... );
+	using StaticFunction = Return( * )( Args... );
+
+	/// <summary>
+	/// Bidirectional iterator over the packed invocation list. Dereferencing
+	/// reassembles an Invoker from the parallel arrays, removed slots that
+	/// have not been compacted yet are skipped.
+	/// </summary>
+	class const_iterator
+	{
+	public:
+
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type        = InvokerType;
+		using difference_type   = ptrdiff_t;
+		using pointer           = void;
+		using reference         = InvokerType;
+
+		const_iterator()
+			: m_Delegate( nullptr )
+			, m_Index( 0 )
+		{ }
+
+		const_iterator( const DelegateType* a_Delegate, size_t a_Index )
+			: m_Delegate( a_Delegate )
+			, m_Index( a_Index )
+		{
+			SkipForward();
+		}
+
+		inline InvokerType operator*() const { return m_Delegate->GetInvoker( m_Index ); }
+
+		inline const_iterator& operator++() { ++m_Index; SkipForward(); return *this; }
+		inline const_iterator& operator--() { --m_Index; SkipBackward(); return *this; }
+		inline const_iterator operator++( int ) { const_iterator Result = *this; operator++(); return Result; }
+		inline const_iterator operator--( int ) { const_iterator Result = *this; operator--(); return Result; }
+
+		inline bool operator==( const const_iterator& a_Other ) const { return m_Index == a_Other.m_Index && m_Delegate == a_Other.m_Delegate; }
+		inline bool operator!=( const const_iterator& a_Other ) const { return !operator==( a_Other ); }
+
+		inline size_t GetIndex() const { return m_Index; }
+
+	private:
+
+		inline void SkipForward()
+		{
+			while ( m_Index < m_Delegate->m_Invocations.size() && !m_Delegate->m_Invocations[ m_Index ] )
+			{
+				++m_Index;
+			}
+		}
+
+		inline void SkipBackward()
+		{
+			while ( m_Index > 0 && !m_Delegate->m_Invocations[ m_Index ] )
+			{
+				--m_Index;
+			}
+		}
+
+		const DelegateType* m_Delegate;
+		size_t              m_Index;
+
+	};
+
+	using iterator = const_iterator;
+
+	Delegate( DelegateOrdering a_Ordering = DelegateOrdering::Ordered )
+		: m_FreeHandle( NoHandle )
+		, m_Holes( 0 )
+		, m_AffineCount( 0 )
+		, m_FilterCount( 0 )
+		, m_StagedBegin( NoIndex )
+		, m_InvokeDepth( 0 )
+		, m_Ordering( a_Ordering )
+		, m_GroupedEnd( 0 )
+		, m_Connections( nullptr )
+		, m_QueueLimit( 0 )
+	{ }
+
+	Delegate( const DelegateType& a_Other )
+		: Delegate( a_Other.m_Ordering )
+	{
+		Merge( a_Other );
+	}
+
+	Delegate( DelegateType&& a_Other )
+		: StatisticsTable( std::move( a_Other.Statistics() ) )
+		, m_Invocations( std::move( a_Other.m_Invocations ) )
+		, m_Objects( std::move( a_Other.m_Objects ) )
+		, m_Functions( std::move( a_Other.m_Functions ) )
+		, m_Managers( std::move( a_Other.m_Managers ) )
+		, m_Priorities( std::move( a_Other.m_Priorities ) )
+		, m_Affinities( std::move( a_Other.m_Affinities ) )
+		, m_FilterKeys( std::move( a_Other.m_FilterKeys ) )
+		, m_IsFiltered( std::move( a_Other.m_IsFiltered ) )
+		, m_HandleIndices( std::move( a_Other.m_HandleIndices ) )
+		, m_Tombstones( std::move( a_Other.m_Tombstones ) )
+		, m_Handles( std::move( a_Other.m_Handles ) )
+		, m_ByObject( std::move( a_Other.m_ByObject ) )
+		, m_ByFunction( std::move( a_Other.m_ByFunction ) )
+		, m_ByInvocation( std::move( a_Other.m_ByInvocation ) )
+		, m_FreeHandle( a_Other.m_FreeHandle )
+		, m_Holes( a_Other.m_Holes )
+		, m_AffineCount( a_Other.m_AffineCount )
+		, m_FilterCount( a_Other.m_FilterCount )
+		, m_Projection( a_Other.m_Projection )
+		, m_StagedBegin( a_Other.m_StagedBegin )
+		, m_InvokeDepth( 0 )
+		, m_Ordering( a_Other.m_Ordering )
+		, m_GroupedEnd( a_Other.m_GroupedEnd )
+		, m_Connections( a_Other.m_Connections )
+		, m_Composition( std::move( a_Other.m_Composition ) )
+		, m_Queue( std::move( a_Other.m_Queue ) )
+		, m_Flushing( std::move( a_Other.m_Flushing ) )
+		, m_QueueLimit( a_Other.m_QueueLimit )
+	{
+		a_Other.m_Connections = nullptr;
+		RetargetConnections();
+		RetargetComposition( a_Other );
+		a_Other.Clear();
+	}
+
+	~Delegate()
+	{
+		DetachComposition();
+		DestroyLambdas();
+		DetachConnections();
+
+#ifdef DELEGATE_HAS_COROUTINES
+		while ( Awaiter* Current = m_Waiters.Head )
+		{
+			Current->Unlink();
+		}
+#endif
+	}
+
+	DelegateType& operator=( const DelegateType& a_Other )
+	{
+		if ( this != &a_Other )
+		{
+			Clear();
+			Merge( a_Other );
+		}
+
+		return *this;
+	}
+
+	DelegateType& operator=( DelegateType&& a_Other )
+	{
+		if ( this != &a_Other )
+		{
+			DetachComposition();
+			DestroyLambdas();
+			DetachConnections();
+			m_Invocations   = std::move( a_Other.m_Invocations );
+			m_Objects       = std::move( a_Other.m_Objects );
+			m_Functions     = std::move( a_Other.m_Functions );
+			m_Managers      = std::move( a_Other.m_Managers );
+			m_Priorities    = std::move( a_Other.m_Priorities );
+			m_Affinities    = std::move( a_Other.m_Affinities );
+			m_FilterKeys    = std::move( a_Other.m_FilterKeys );
+			m_IsFiltered    = std::move( a_Other.m_IsFiltered );
+			m_HandleIndices = std::move( a_Other.m_HandleIndices );
+			m_Tombstones    = std::move( a_Other.m_Tombstones );
+			m_Handles       = std::move( a_Other.m_Handles );
+			m_ByObject      = std::move( a_Other.m_ByObject );
+			m_ByFunction    = std::move( a_Other.m_ByFunction );
+			m_ByInvocation  = std::move( a_Other.m_ByInvocation );
+			m_FreeHandle    = a_Other.m_FreeHandle;
+			m_Holes         = a_Other.m_Holes;
+			m_AffineCount   = a_Other.m_AffineCount;
+			m_FilterCount   = a_Other.m_FilterCount;
+			m_Projection    = a_Other.m_Projection;
+			m_StagedBegin   = a_Other.m_StagedBegin;
+			m_Ordering      = a_Other.m_Ordering;
+			m_GroupedEnd    = a_Other.m_GroupedEnd;
+			m_Connections   = a_Other.m_Connections;
+			m_Composition   = std::move( a_Other.m_Composition );
+			m_Queue         = std::move( a_Other.m_Queue );
+			m_Flushing      = std::move( a_Other.m_Flushing );
+			m_QueueLimit    = a_Other.m_QueueLimit;
+			Statistics()    = std::move( a_Other.Statistics() );
+			a_Other.m_Connections = nullptr;
+			RetargetConnections();
+			RetargetComposition( a_Other );
+			a_Other.Clear();
+		}
+
+		return *this;
+	}
+
+	/// <summary>
+	/// While invoking this removes every subscriber like Remove does, and
+	/// the storage is released once the outermost dispatch returns.
+	/// </summary>
+	inline void Clear()
+	{
+		if ( m_InvokeDepth )
+		{
+			for ( size_t i = 0; i < m_Invocations.size(); ++i )
+			{
+				if ( m_Invocations[ i ] )
+				{
+					Erase( i );
+				}
+			}
+
+			return;
+		}
+
+		DestroyLambdas();
+		m_Invocations.clear();
+		m_Objects.clear();
+		m_Functions.clear();
+		m_Managers.clear();
+		m_Priorities.clear();
+		m_Affinities.clear();
+		m_FilterKeys.clear();
+		m_IsFiltered.clear();
+		m_HandleIndices.clear();
+		m_Handles.clear();
+		m_ByObject.Clear();
+		m_ByFunction.Clear();
+		m_ByInvocation.Clear();
+		m_FreeHandle = NoHandle;
+		m_Holes = 0;
+		m_AffineCount = 0;
+		m_FilterCount = 0;
+		m_Tombstones.clear();
+		m_StagedBegin = NoIndex;
+		m_GroupedEnd = 0;
+		Touch();
+	}
+
+	inline size_t GetCount() const { return m_Invocations.size() - m_Holes; }
+
+	inline bool IsInvoking() const { return m_InvokeDepth != 0; }
+
+	inline DelegateOrdering GetOrdering() const { return m_Ordering; }
+
+	/// <summary>
+	/// Switching to Unordered lets the next broadcast regroup the list,
+	/// indices then refer to the grouped order.
+	/// </summary>
+	inline void SetOrdering( DelegateOrdering a_Ordering )
+	{
+		m_Ordering = a_Ordering;
+		m_GroupedEnd = 0;
+		Touch();
+	}
+
+	inline bool IsValid( DelegateHandle a_DelegateHandle ) const { return FindHandle( a_DelegateHandle ) != NoIndex; }
+
+	inline int32_t GetPriority( DelegateHandle a_DelegateHandle ) const
+	{
+		const size_t Index = FindHandle( a_DelegateHandle );
+		return Index == NoIndex ? 0 : m_Priorities[ Index ];
+	}
+
+	inline std::vector< InvokerType > GetInvocationList() const { return std::vector< InvokerType >( begin(), end() ); }
+
+	/// <summary>
+	/// Call counts and latencies of the current subscribers in invocation
+	/// order. Empty unless the delegate's instrumentation policy records
+	/// them.
+	/// </summary>
+	std::vector< SubscriberStatistics > GetStatistics() const
+	{
+		std::vector< SubscriberStatistics > Result;
+
+		for ( size_t i = 0; i < m_Invocations.size(); ++i )
+		{
+			const uint32_t Slot = m_HandleIndices[ i ];
+			const LatencyHistogram* Histogram = m_Invocations[ i ] ? Statistics().FindSlot( Slot ) : nullptr;
+
+			if ( Histogram )
+			{
+				Result.push_back( { DelegateHandle( Slot, m_Handles[ Slot ].Generation ),
+									Histogram->GetCount(),
+									Histogram->GetTotal(),
+									Histogram->GetMax(),
+									Histogram->GetPercentile( 50.0 ),
+									Histogram->GetPercentile( 99.0 ),
+									Histogram->GetPercentile( 99.9 ) } );
+			}
+		}
+
+		return Result;
+	}
+
+	/// <summary>
+	/// Writes GetStatistics as a JSON object named a_Name.
+	/// </summary>
+	void ExportStatistics( std::ostream& a_Stream, const char* a_Name ) const
+	{
+		const std::vector< SubscriberStatistics > Entries = GetStatistics();
+		a_Stream << "{ \"delegate\": \"" << a_Name << "\", \"subscribers\": [";
+
+		for ( size_t i = 0; i < Entries.size(); ++i )
+		{
+			const SubscriberStatistics& Current = Entries[ i ];
+			a_Stream << ( i ? ",\n  " : "\n  " )
+					 << "{ \"slot\": " << Current.Handle.m_Index
+					 << ", \"calls\": " << Current.Calls
+					 << ", \"total_ns\": " << Current.TotalNanoseconds
+					 << ", \"max_ns\": " << Current.MaxNanoseconds
+					 << ", \"p50_ns\": " << Current.P50Nanoseconds
+					 << ", \"p99_ns\": " << Current.P99Nanoseconds
+					 << ", \"p999_ns\": " << Current.P999Nanoseconds << " }";
+		}
+
+		a_Stream << "\n] }\n";
+	}
+
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline Return Invoke( size_t a_Index, Params&&... a_Params )
+	{
+		return InvokeAt( a_Index, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline Return Invoke( DelegateHandle a_DelegateHandle, Params&&... a_Params )
+	{
+		return InvokeAt( a_DelegateHandle, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Every subscriber sees the caller's arguments by reference. The only
+	/// copies made are the ones a target asks for by taking a parameter by
+	/// value.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline void InvokeAll( Params&&... a_Params )
+	{
+		Broadcast( FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline void InvokeAll( std::vector< Return >& a_Output, Params&&... a_Params )
+	{
+		Broadcast( a_Output, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Folds results into a_Combiner as they are produced instead of storing
+	/// them. Returns true if the combiner stopped the broadcast, in which
+	/// case the remaining subscribers were skipped. Unordered delegates stop
+	/// in grouped order.
+	/// </summary>
+	template < typename Combiner, typename... Params, typename = FunctionTraits::EnableIfCombiner< Combiner, Return, std::tuple< Args... >, Params... > >
+	inline bool InvokeAll( Combiner&& a_Combiner, Params&&... a_Params )
+	{
+		return Combine( a_Combiner, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Copies the arguments into the event queue for a later Flush, the
+	/// arguments of reference parameters included. Once the queue has
+	/// grown to the peak backlog this only constructs the event in place.
+	/// Returns false if a queue limit is set and reached. Single threaded
+	/// like the rest of Delegate, ConcurrentDelegate takes events from any
+	/// number of producers.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline bool Enqueue( Params&&... a_Params )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+
+		if ( m_QueueLimit && m_Queue.GetCount() >= m_QueueLimit )
+		{
+			return false;
+		}
+
+		m_Queue.Push( std::forward< Params >( a_Params )... );
+		return true;
+	}
+
+	inline void ReserveQueue( size_t a_Capacity )
+	{
+		m_Queue.Reserve( a_Capacity );
+		m_Flushing.Reserve( a_Capacity );
+	}
+
+	/// <summary>
+	/// Bounds the events Enqueue holds between flushes and reserves room
+	/// for them up front, so enqueueing never allocates. 0 lets the queue
+	/// grow as needed.
+	/// </summary>
+	inline void SetQueueLimit( size_t a_Limit )
+	{
+		m_QueueLimit = a_Limit;
+		ReserveQueue( a_Limit );
+	}
+
+	inline size_t GetQueueLimit() const { return m_QueueLimit; }
+
+	inline size_t GetQueuedCount() const { return m_Queue.GetCount(); }
+
+	/// <summary>
+	/// Broadcasts the queued events oldest first in a single invoking
+	/// section and returns how many were dispatched. Events enqueued by
+	/// subscribers meanwhile wait for the next Flush, a nested Flush does
+	/// nothing.
+	/// </summary>
+	size_t Flush()
+	{
+		if ( m_Flushing.GetCount() )
+		{
+			return 0;
+		}
+
+		m_Flushing.Swap( m_Queue );
+		const size_t Count = m_Flushing.GetCount();
+
+		Arrange();
+		InvocationScope Scope( *this );
+
+		while ( m_Flushing.GetCount() )
+		{
+			QueuedEvent& Event = m_Flushing.Front();
+			DispatchUnpacked( GetDispatchEnd(), Event, std::index_sequence_for< Args... >() );
+			ResumeUnpacked( Event, std::index_sequence_for< Args... >() );
+			m_Flushing.Pop();
+		}
+
+		return Count;
+	}
+
+#ifdef DELEGATE_HAS_COROUTINES
+	/// <summary>
+	/// Returned by Next and kept in the awaiting coroutine's frame. While
+	/// suspended it is linked into the delegate's waiter list, so waiting
+	/// allocates nothing.
+	/// </summary>
+	class Awaiter
+	{
+	public:
+
+		Awaiter( const Awaiter& ) = delete;
+		Awaiter& operator=( const Awaiter& ) = delete;
+
+		~Awaiter()
+		{
+			Unlink();
+		}
+
+		inline bool await_ready() const noexcept { return false; }
+
+		inline void await_suspend( std::coroutine_handle<> a_Handle ) noexcept
+		{
+			m_Handle = a_Handle;
+			Link( m_Delegate->m_Waiters );
+		}
+
+		inline QueuedEvent await_resume() const { return QueuedEvent( *m_Arguments ); }
+
+	private:
+
+		using Arguments = std::tuple< FunctionTraits::ForwardType< Args >... >;
+
+		struct List
+		{
+			Awaiter* Head = nullptr;
+			Awaiter* Tail = nullptr;
+		};
+
+		explicit Awaiter( DelegateType& a_Delegate )
+			: m_Delegate( &a_Delegate )
+			, m_List( nullptr )
+			, m_Previous( nullptr )
+			, m_Next( nullptr )
+			, m_Arguments( nullptr )
+		{ }
+
+		inline void Link( List& a_List )
+		{
+			m_List = &a_List;
+			m_Previous = a_List.Tail;
+			m_Next = nullptr;
+			( m_Previous ? m_Previous->m_Next : a_List.Head ) = this;
+			a_List.Tail = this;
+		}
+
+		inline void Unlink()
+		{
+			if ( !m_List )
+			{
+				return;
+			}
+
+			( m_Previous ? m_Previous->m_Next : m_List->Head ) = m_Next;
+			( m_Next ? m_Next->m_Previous : m_List->Tail ) = m_Previous;
+			m_List = nullptr;
+		}
+
+		DelegateType*           m_Delegate;
+		std::coroutine_handle<> m_Handle;
+		List*                   m_List;
+		Awaiter*                m_Previous;
+		Awaiter*                m_Next;
+		const Arguments*        m_Arguments;
+
+		friend class Delegate;
+	};
+
+	/// <summary>
+	/// co_await Next() suspends until the next broadcast and yields its
+	/// arguments. Waiters are resumed together after the subscribers ran,
+	/// still inside the broadcast. Waiters left when the delegate is
+	/// destroyed are never resumed.
+	/// </summary>
+	inline Awaiter Next() { return Awaiter( *this ); }
+#endif
+
+	/// <summary>
+	/// Dispatches a batch of events, running each subscriber over the whole
+	/// batch before moving on to the next one. The list is compacted once
+	/// for the batch. A subscriber removed mid batch skips its remaining
+	/// events. With thread bound or filtered subscribers, which are sorted
+	/// out per event, or with attached delegates the batch goes event by
+	/// event instead.
+	/// </summary>
+	void InvokeAll( std::tuple< Args... >* a_Events, size_t a_Count )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		Arrange();
+		InvocationScope Scope( *this );
+		const size_t End = GetDispatchEnd();
+
+		if ( m_AffineCount || m_FilterCount || HasChildren() )
+		{
+			for ( size_t i = 0; i < a_Count; ++i )
+			{
+				DispatchUnpacked( End, a_Events[ i ], std::index_sequence_for< Args... >() );
+			}
+		}
+		else
+		{
+			for ( size_t Index = 0; Index < End; ++Index )
+			{
+				for ( size_t i = 0; i < a_Count && m_Invocations[ Index ]; ++i )
+				{
+					InvokeUnpacked( Index, a_Events[ i ], std::index_sequence_for< Args... >() );
+				}
+			}
+		}
+
+		for ( size_t i = 0; i < a_Count; ++i )
+		{
+			ResumeUnpacked( a_Events[ i ], std::index_sequence_for< Args... >() );
+		}
+	}
+
+	inline void InvokeAll( std::vector< std::tuple< Args... > >& a_Events )
+	{
+		InvokeAll( a_Events.data(), a_Events.size() );
+	}
+
+	/// <summary>
+	/// Runs the invocation list in chunks across DelegateThreadPool and joins
+	/// before returning. The whole broadcast is one invoking section, chunks
+	/// on other threads do not enter their own. Subscribers run concurrently
+	/// and must not modify the delegate.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline void InvokeAllParallel( Params&&... a_Params )
+	{
+		BroadcastParallel( FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Results are appended in subscriber order regardless of which thread
+	/// produced them.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline void InvokeAllParallel( std::vector< Return >& a_Output, Params&&... a_Params )
+	{
+		BroadcastParallel( a_Output, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	inline InvokerType operator[] ( size_t a_Index )
+	{
+		Compact();
+		return GetInvoker( a_Index );
+	}
+
+	inline InvokerType operator[] ( DelegateHandle a_DelegateHandle ) const
+	{
+		const size_t Index = FindHandle( a_DelegateHandle );
+		return Index == NoIndex ? InvokerType() : GetInvoker( Index );
+	}
+
+	inline DelegateHandle Add( const InvokerType& a_Invoker )
+	{
+		return Add( 0, a_Invoker );
+	}
+
+	inline void Add( const DelegateType& a_Delegate )
+	{
+		Merge( a_Delegate );
+	}
+
+	/// <summary>
+	/// Attaches a_Child by reference, unlike Add which copies its current
+	/// subscribers. Broadcasts then reach a_Child's subscribers, and those
+	/// of the delegates attached to it, after this delegate's own. They run
+	/// from one flattened array that is rebuilt when any delegate in the
+	/// tree has changed since. Returns false for this delegate, one already
+	/// attached, or one that would close a cycle.
+	/// </summary>
+	bool Attach( DelegateType& a_Child )
+	{
+		if ( a_Child.Reaches( *this ) || ( m_Composition && std::find( m_Composition->Children.begin(), m_Composition->Children.end(), &a_Child ) != m_Composition->Children.end() ) )
+		{
+			return false;
+		}
+
+		Compose().Children.push_back( &a_Child );
+		a_Child.Compose().Parents.push_back( this );
+		Invalidate();
+		return true;
+	}
+
+	bool Detach( DelegateType& a_Child )
+	{
+		if ( !m_Composition )
+		{
+			return false;
+		}
+
+		StorageVector< DelegateType* >& Children = m_Composition->Children;
+		const auto Found = std::find( Children.begin(), Children.end(), &a_Child );
+
+		if ( Found == Children.end() )
+		{
+			return false;
+		}
+
+		Withdraw( a_Child );
+		Children.erase( Found );
+		a_Child.Unparent( *this );
+		Invalidate();
+		return true;
+	}
+
+	inline size_t GetChildCount() const { return m_Composition ? m_Composition->Children.size() : 0; }
+
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	inline DelegateHandle Add( Lambda a_Lambda )
+	{
+		return Add( 0, InvokerType( a_Lambda ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Add( Object* a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Add( 0, InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Add( Object& a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Add( 0, InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	inline DelegateHandle Add( StaticFunction a_StaticFunction )
+	{
+		return Add( 0, InvokerType( a_StaticFunction ) );
+	}
+
+#ifdef __cpp_nontype_template_parameter_auto
+	template < auto Function >
+	inline DelegateHandle Add()
+	{
+		return Add( 0, InvokerType::template Bind< Function >() );
+	}
+
+	template < auto Function, typename Object >
+	inline DelegateHandle Add( Object& a_Object )
+	{
+		return Add( 0, InvokerType::template Bind< Function >( a_Object ) );
+	}
+
+	template < auto Function, typename Object >
+	inline DelegateHandle Add( Object* a_Object )
+	{
+		return Add( 0, InvokerType::template Bind< Function >( *a_Object ) );
+	}
+#endif
+
+	/// <summary>
+	/// Adds a subscriber behind every subscriber of the same or a higher
+	/// priority and ahead of every lower one. Plain Add uses priority zero,
+	/// so a delegate that never names a priority keeps insertion order.
+	/// </summary>
+	inline DelegateHandle Add( int32_t a_Priority, const InvokerType& a_Invoker )
+	{
+		return Emplace( FindPriorityIndex( a_Priority ), a_Invoker, a_Priority, true );
+	}
+
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	inline DelegateHandle Add( int32_t a_Priority, Lambda a_Lambda )
+	{
+		return Add( a_Priority, InvokerType( a_Lambda ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Add( int32_t a_Priority, Object* a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Add( a_Priority, InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Add( int32_t a_Priority, Object& a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Add( a_Priority, InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	inline DelegateHandle Add( int32_t a_Priority, StaticFunction a_StaticFunction )
+	{
+		return Add( a_Priority, InvokerType( a_StaticFunction ) );
+	}
+
+#ifdef __cpp_nontype_template_parameter_auto
+	template < auto Function >
+	inline DelegateHandle Add( int32_t a_Priority )
+	{
+		return Add( a_Priority, InvokerType::template Bind< Function >() );
+	}
+
+	template < auto Function, typename Object >
+	inline DelegateHandle Add( int32_t a_Priority, Object& a_Object )
+	{
+		return Add( a_Priority, InvokerType::template Bind< Function >( a_Object ) );
+	}
+
+	template < auto Function, typename Object >
+	inline DelegateHandle Add( int32_t a_Priority, Object* a_Object )
+	{
+		return Add( a_Priority, InvokerType::template Bind< Function >( *a_Object ) );
+	}
+#endif
+
+	/// <summary>
+	/// Adds like Add and binds the subscriber to a_Executor's thread.
+	/// Broadcasts from that thread call it directly. Broadcasts from any
+	/// other copy the event into a single post per executor, run by its
+	/// next Pump. Removing the subscriber drops calls still queued for it,
+	/// its binding is freed by the Pump after.
+	/// </summary>
+	template < typename... Params >
+	DelegateHandle Add( DelegateExecutor& a_Executor, Params&&... a_Params )
+	{
+		static_assert( IsAffinable, "Thread bound subscribers need a void delegate with copyable arguments." );
+		const DelegateHandle Handle = Add( std::forward< Params >( a_Params )... );
+
+		if ( Handle.IsValid() )
+		{
+			BindAt( FindHandle( Handle ), a_Executor );
+		}
+
+		return Handle;
+	}
+
+#ifdef __cpp_nontype_template_parameter_auto
+	template < auto Function, typename... Params >
+	DelegateHandle Add( DelegateExecutor& a_Executor, Params&&... a_Params )
+	{
+		static_assert( IsAffinable, "Thread bound subscribers need a void delegate with copyable arguments." );
+		const DelegateHandle Handle = Add< Function >( std::forward< Params >( a_Params )... );
+
+		if ( Handle.IsValid() )
+		{
+			BindAt( FindHandle( Handle ), a_Executor );
+		}
+
+		return Handle;
+	}
+#endif
+
+	/// <summary>
+	/// Adds like Add, with a_Filter deciding which broadcasts reach the
+	/// subscriber. Broadcasts evaluate all filters in bulk and call only
+	/// the matches, direct Invoke calls ignore them. A delegate's filters
+	/// share one key projection, a filter projecting another key while any
+	/// are left is refused with an invalid handle.
+	/// </summary>
+	template < size_t Index, typename Key, typename Projection, typename... Params >
+	DelegateHandle Add( const DelegateFilter< Index, Key, Projection >& a_Filter, Params&&... a_Params )
+	{
+		static_assert( Index < sizeof...( Args ), "The filter names an argument the delegate does not have." );
+
+		if ( !UseProjection< Index >( a_Filter.Project ) )
+		{
+			return DelegateHandle();
+		}
+
+		const DelegateHandle Handle = Add( std::forward< Params >( a_Params )... );
+
+		if ( Handle.IsValid() )
+		{
+			FilterAt( FindHandle( Handle ), ToFilterKey( static_cast< ProjectedKey< Index, Projection > >( a_Filter.Value ) ) );
+		}
+
+		return Handle;
+	}
+
+#ifdef __cpp_nontype_template_parameter_auto
+	template < auto Function, size_t Index, typename Key, typename Projection, typename... Params >
+	DelegateHandle Add( const DelegateFilter< Index, Key, Projection >& a_Filter, Params&&... a_Params )
+	{
+		static_assert( Index < sizeof...( Args ), "The filter names an argument the delegate does not have." );
+
+		if ( !UseProjection< Index >( a_Filter.Project ) )
+		{
+			return DelegateHandle();
+		}
+
+		const DelegateHandle Handle = Add< Function >( std::forward< Params >( a_Params )... );
+
+		if ( Handle.IsValid() )
+		{
+			FilterAt( FindHandle( Handle ), ToFilterKey( static_cast< ProjectedKey< Index, Projection > >( a_Filter.Value ) ) );
+		}
+
+		return Handle;
+	}
+#endif
+
+	/// <summary>
+	/// Executor the subscriber is bound to, null if it runs on whichever
+	/// thread broadcasts.
+	/// </summary>
+	inline DelegateExecutor* GetExecutor( DelegateHandle a_DelegateHandle ) const
+	{
+		const size_t Index = FindHandle( a_DelegateHandle );
+		return Index == NoIndex || !m_Affinities[ Index ] ? nullptr : m_Affinities[ Index ]->Executor;
+	}
+
+	/// <summary>
+	/// Adds like Add and returns a connection that removes the subscriber
+	/// when it goes out of scope. Moving the delegate keeps its
+	/// connections, copies get none.
+	/// </summary>
+	template < typename... Params >
+	ScopedConnection Connect( Params&&... a_Params )
+	{
+		return MakeConnection( Add( std::forward< Params >( a_Params )... ) );
+	}
+
+#ifdef __cpp_nontype_template_parameter_auto
+	template < auto Function, typename... Params >
+	ScopedConnection Connect( Params&&... a_Params )
+	{
+		return MakeConnection( Add< Function >( std::forward< Params >( a_Params )... ) );
+	}
+#endif
+
+	DelegateHandle Insert( const const_iterator& a_Where, const InvokerType& a_Invoker )
+	{
+		return Emplace( a_Where.GetIndex(), a_Invoker );
+	}
+
+	inline void Insert( const const_iterator& a_Where, const DelegateType& a_Delegate )
+	{
+		InsertAt( a_Where.GetIndex(), a_Delegate );
+	}
+
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	inline DelegateHandle Insert( const const_iterator& a_Where, Lambda a_Lambda )
+	{
+		return Emplace( a_Where.GetIndex(), InvokerType( a_Lambda ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Insert( const const_iterator& a_Where, Object* a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Emplace( a_Where.GetIndex(), InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Insert( const const_iterator& a_Where, Object& a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Emplace( a_Where.GetIndex(), InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	inline DelegateHandle Insert( const const_iterator& a_Where, StaticFunction a_StaticFunction )
+	{
+		return Emplace( a_Where.GetIndex(), InvokerType( a_StaticFunction ) );
+	}
+
+	DelegateHandle Insert( size_t a_Index, const InvokerType& a_Invoker )
+	{
+		Compact();
+		return Emplace( a_Index, a_Invoker );
+	}
+
+	void Insert( size_t a_Index, const DelegateType& a_Delegate )
+	{
+		Compact();
+		InsertAt( a_Index, a_Delegate );
+	}
+
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	DelegateHandle Insert( size_t a_Index, Lambda a_Lambda )
+	{
+		Compact();
+		return Emplace( a_Index, InvokerType( a_Lambda ) );
+	}
+
+	template < typename Object >
+	DelegateHandle Insert( size_t a_Index, Object* a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		Compact();
+		return Emplace( a_Index, InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	template < typename Object >
+	DelegateHandle Insert( size_t a_Index, Object& a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		Compact();
+		return Emplace( a_Index, InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	DelegateHandle Insert( size_t a_Index, StaticFunction a_StaticFunction )
+	{
+		Compact();
+		return Emplace( a_Index, InvokerType( a_StaticFunction ) );
+	}
+
+	bool Remove( size_t a_Index )
+	{
+		Compact();
+		return RemoveAt( a_Index );
+	}
+
+	bool Remove( const InvokerType& a_Invoker )
+	{
+		return RemoveAt( FindInvoker( a_Invoker ) );
+	}
+
+	bool Remove( DelegateHandle a_DelegateHandle )
+	{
+		return RemoveAt( FindHandle( a_DelegateHandle ) );
+	}
+
+	bool Remove( const const_iterator& a_Where )
+	{
+		return RemoveAt( a_Where.GetIndex() );
+	}
+
+	/// <summary>
+	/// Remove no longer waits for a dispatch to end, so these are the same.
+	/// </summary>
+	[[deprecated( "Use Remove." )]]
+	inline bool ForceRemove( size_t a_Index ) { return Remove( a_Index ); }
+
+	[[deprecated( "Use Remove." )]]
+	inline bool ForceRemove( const InvokerType& a_Invoker ) { return Remove( a_Invoker ); }
+
+	[[deprecated( "Use Remove." )]]
+	inline bool ForceRemove( DelegateHandle a_DelegateHandle ) { return Remove( a_DelegateHandle ); }
+
+	[[deprecated( "Use Remove." )]]
+	inline bool ForceRemove( const const_iterator& a_Where ) { return Remove( a_Where ); }
+
+	/// <summary>
+	/// Removes every subscriber equal to a_Lambda, see Invoker::operator==.
+	/// </summary>
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	bool RemoveAll( Lambda a_Lambda )
+	{
+		return RemoveChain( m_ByInvocation, m_ByInvocation.GetFirst( InvokerType::template FunctorLambda< Lambda > ), [ & ]( size_t a_Index )
+		{
+			return m_Managers[ a_Index ]( LambdaOperation::Compare, &a_Lambda, m_Objects[ a_Index ] ) != nullptr;
+		} );
+	}
+
+	/// <summary>
+	/// Removes every member function subscriber bound to a_Object.
+	/// </summary>
+	template < typename Object >
+	bool RemoveAll( Object* a_Object )
+	{
+		return RemoveChain( m_ByObject, m_ByObject.GetFirst( const_cast< void* >( static_cast< const void* >( a_Object ) ) ) );
+	}
+
+	/// <summary>
+	/// Removes a_MemberFunction from every object it is bound to, whether
+	/// added with the pointer or bound at compile time.
+	/// </summary>
+	template < typename Object >
+	bool RemoveAll( MemberFunction< Object > a_MemberFunction )
+	{
+		using Function = MemberFunction< Object >;
+
+		// Another pointer may hash to the same chain, so the type is checked before comparing.
+		const auto IsMatch = [ & ]( size_t a_Index )
+		{
+			const LambdaManager Manager = m_Managers[ a_Index ];
+			return ( Manager == InvokerType::template ManageLambda< Function > || Manager == InvokerType::template ManageConstant< Function > ) &&
+				   Manager( LambdaOperation::Compare, &a_MemberFunction, m_Functions[ a_Index ] ) != nullptr;
+		};
+
+		return RemoveChain( m_ByFunction, m_ByFunction.GetFirst( InvokerType::HashBytes( a_MemberFunction ) ), IsMatch );
+	}
+
+	bool RemoveAll( StaticFunction a_StaticFunction )
+	{
+		return RemoveChain( m_ByFunction, m_ByFunction.GetFirst( reinterpret_cast< void* >( a_StaticFunction ) ), [ this ]( size_t a_Index )
+		{
+			return !m_Managers[ a_Index ];
+		} );
+	}
+
+	void operator+=( const InvokerType& a_Invoker )
+	{
+		Add( a_Invoker );
+	}
+
+	void operator+=( const DelegateType& a_Delegate )
+	{
+
+	}
+	
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	void operator+=( Lambda a_Lambda )
+	{
+
+	}
+
+	void operator+=( StaticFunction a_StaticFunction )
+	{
+
+	}
+
+	void operator-= ( size_t a_Index )
+	{
+
+	}
+
+	void operator-= ( DelegateHandle a_DelegateHandle )
+	{
+
+	}
+
+	void operator-= ( const const_iterator& a_Where )
+	{
+
+	}
+
+	void operator-= ( const InvokerType& a_Invoker )
+	{
+
+	}
+	
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	void operator-= ( Lambda a_Lambda )
+	{
+
+	}
+
+	void operator-= ( StaticFunction a_StaticFunction )
+	{
+
+	}
+	inline const_iterator begin() const
+	{
+		// Merging only reorders, what the delegate holds stays the same.
+		const_cast< DelegateType* >( this )->MergePending();
+		return const_iterator( this, 0 );
+	}
+
+	inline const_iterator end() const
+	{
+		return const_iterator( this, m_Invocations.size() );
+	}
+
+private:
+
+	static constexpr uint32_t NoHandle = ~uint32_t( 0 );
+	static constexpr size_t   NoIndex  = ~size_t( 0 );
+	static constexpr size_t   MinParallelChunk = 8;
+
+	/// <summary>
+	/// Slot table entry. Index is the subscriber's position in the packed
+	/// arrays while live, and the next free slot once released.
+	/// </summary>
+	struct HandleSlot
+	{
+		uint32_t Index;
+		uint32_t Generation;
+	};
+
+	/// <summary>
+	/// Result of one subscriber in a collecting parallel broadcast, built in
+	/// place by whichever thread ran it, so Return needs no default
+	/// constructor.
+	/// </summary>
+	struct ParallelResult
+	{
+		using ValueType = std::conditional_t< std::is_void< Return >::value, char, Return >;
+		using Storage   = typename std::aligned_storage< sizeof( ValueType ), alignof( ValueType ) >::type;
+
+		Storage Value;
+		bool    IsLive;
+	};
+
+	/// <summary>
+	/// Counts nested dispatches. While any is running the packed arrays
+	/// never move: removals leave tombstones and additions are staged at
+	/// the end, so every dispatch loop can keep a plain local index. The
+	/// outermost scope settles both in one pass.
+	/// </summary>
+	struct InvocationScope
+	{
+		InvocationScope( DelegateType& a_Delegate )
+			: m_Delegate( a_Delegate )
+		{
+			++m_Delegate.m_InvokeDepth;
+		}
+
+		~InvocationScope()
+		{
+			if ( --m_Delegate.m_InvokeDepth == 0 )
+			{
+				m_Delegate.Settle();
+			}
+		}
+
+		DelegateType& m_Delegate;
+	};
+
+	/// <summary>
+	/// End of the subscribers a dispatch visits. Those staged while
+	/// invoking wait for the outermost dispatch to return.
+	/// </summary>
+	inline size_t GetDispatchEnd() const { return m_StagedBegin == NoIndex ? m_Invocations.size() : m_StagedBegin; }
+
+	/// <summary>
+	/// Posted calls carry a copy of the event and return nothing, so only
+	/// delegates of that shape can bind subscribers to an executor.
+	/// </summary>
+	static constexpr bool IsAffinable = std::is_void< Return >::value && std::is_copy_constructible< QueuedEvent >::value;
+
+	/// <summary>
+	/// Binding of a subscriber to its executor, named by the posts made for
+	/// it. When the subscriber is removed the affinity takes over its
+	/// lambda state and is itself posted to the executor. Posts only ever
+	/// queue up behind the ones already there, so every call still naming
+	/// it has been skipped by the time it is destroyed.
+	/// </summary>
+	struct Affinity
+		: DelegateExecutor::Task
+	{
+		Affinity( DelegateExecutor& a_Executor, InvocationFunction a_Invocation, void* a_Object, void* a_Function )
+			: DelegateExecutor::Task( &Affinity::Retire )
+			, Executor( &a_Executor )
+			, Invocation( a_Invocation )
+			, Object( a_Object )
+			, Function( a_Function )
+			, Manager( nullptr )
+			, IsConnected( true )
+		{ }
+
+		static void Retire( DelegateExecutor::Task* a_Task, bool )
+		{
+			std::unique_ptr< Affinity > Target( static_cast< Affinity* >( a_Task ) );
+
+			if ( Target->Manager )
+			{
+				Target->Manager( LambdaOperation::Destroy, nullptr, InvokerType::GetOwned( Target->Object, Target->Function ) );
+			}
+		}
+
+		DelegateExecutor*   Executor;
+		InvocationFunction  Invocation;
+		void*               Object;
+		void*               Function;
+		LambdaManager       Manager;
+		std::atomic< bool > IsConnected;
+	};
+
+	/// <summary>
+	/// One event for the subscribers a broadcast found bound to the same
+	/// foreign executor. Until it is posted it also links the broadcast's
+	/// other posts through Next. The post and its target list share one
+	/// LambdaPool block, so posting does not go to the heap.
+	/// </summary>
+	struct AffinePost
+		: DelegateExecutor::Task
+	{
+		AffinePost( DelegateExecutor* a_Executor, size_t a_Capacity, FunctionTraits::ForwardType< Args >... a_Args )
+			: DelegateExecutor::Task( &AffinePost::Run )
+			, Executor( a_Executor )
+			, Capacity( a_Capacity )
+			, Count( 0 )
+			, Event( FunctionTraits::Pass< Args >( a_Args )... )
+		{ }
+
+		static AffinePost* Create( DelegateExecutor* a_Executor, size_t a_Capacity, FunctionTraits::ForwardType< Args >... a_Args )
+		{
+			void* Block = LambdaPool::Allocate( GetSize( a_Capacity ), alignof( AffinePost ) );
+			return ::new( Block ) AffinePost( a_Executor, a_Capacity, FunctionTraits::Pass< Args >( a_Args )... );
+		}
+
+		static void Destroy( AffinePost* a_Post )
+		{
+			const size_t Size = GetSize( a_Post->Capacity );
+			a_Post->~AffinePost();
+			LambdaPool::Free( a_Post, Size, alignof( AffinePost ) );
+		}
+
+		static void Run( DelegateExecutor::Task* a_Task, bool a_IsRun )
+		{
+			std::unique_ptr< AffinePost, void( * )( AffinePost* ) > Post( static_cast< AffinePost* >( a_Task ), &AffinePost::Destroy );
+			Affinity** Targets = Post->GetTargets();
+
+			for ( size_t i = 0; i < Post->Count && a_IsRun; ++i )
+			{
+				if ( Targets[ i ]->IsConnected.load( std::memory_order_acquire ) )
+				{
+					Post->Call( *Targets[ i ], std::index_sequence_for< Args... >() );
+				}
+			}
+		}
+
+		static inline size_t GetSize( size_t a_Capacity ) { return sizeof( AffinePost ) + a_Capacity * sizeof( Affinity* ); }
+
+		inline Affinity** GetTargets() { return reinterpret_cast< Affinity** >( this + 1 ); }
+
+		inline void Add( Affinity* a_Target ) { GetTargets()[ Count++ ] = a_Target; }
+
+		template < size_t... Indices >
+		inline void Call( const Affinity& a_Target, std::index_sequence< Indices... > )
+		{
+			a_Target.Invocation( a_Target.Object, a_Target.Function, FunctionTraits::Pass< Args >( std::get< Indices >( Event ) )... );
+		}
+
+		DelegateExecutor* Executor;
+		size_t            Capacity;
+		size_t            Count;
+		QueuedEvent       Event;
+	};
+
+	/// <summary>
+	/// The key projection every filter of the delegate shares, erased to a
+	/// thunk that reads the key off a broadcast's arguments.
+	/// </summary>
+	struct KeyProjection
+	{
+		using Extractor = uint64_t( * )( const void*, FunctionTraits::ForwardType< Args >... );
+		using Comparer  = bool( * )( const void*, const void* );
+
+		using Buffer    = typename std::aligned_storage< 2 * sizeof( void* ), alignof( void* ) >::type;
+
+		Extractor Extract = nullptr;
+		Comparer  Equals = nullptr;
+		Buffer    Storage;
+	};
+
+	template < size_t Index >
+	using FilterArgument = std::decay_t< std::tuple_element_t< Index, std::tuple< Args... > > >;
+
+	template < size_t Index, typename Projection >
+	using ProjectedKey = std::decay_t< decltype( DelegateProjection< Projection >::Apply( std::declval< const FilterArgument< Index >& >(), std::declval< Projection >() ) ) >;
+
+	template < typename Value, typename = std::enable_if_t< std::is_integral< Value >::value || std::is_enum< Value >::value > >
+	static inline uint64_t ToFilterKey( Value a_Value )
+	{
+		return static_cast< uint64_t >( a_Value );
+	}
+
+	template < typename Value >
+	static inline uint64_t ToFilterKey( const Value* a_Value )
+	{
+		return reinterpret_cast< uintptr_t >( a_Value );
+	}
+
+	template < size_t Index, typename Projection >
+	static uint64_t ExtractKey( const void* a_Projection, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		return ToFilterKey( DelegateProjection< Projection >::Apply( std::get< Index >( std::forward_as_tuple( a_Args... ) ), *static_cast< const Projection* >( a_Projection ) ) );
+	}
+
+	template < typename Projection >
+	static bool EqualProjections( const void* a_Left, const void* a_Right )
+	{
+		return *static_cast< const Projection* >( a_Left ) == *static_cast< const Projection* >( a_Right );
+	}
+
+	/// <summary>
+	/// Aims for a few chunks per thread so stealing can even out uneven
+	/// subscribers, without going below MinParallelChunk.
+	/// </summary>
+	inline size_t GetParallelChunkSize( const DelegateThreadPool& a_Pool ) const
+	{
+		const size_t Chunks = ( a_Pool.GetWorkerCount() + 1 ) * 4;
+		const size_t ChunkSize = ( m_Invocations.size() + Chunks - 1 ) / Chunks;
+		return ChunkSize < MinParallelChunk ? MinParallelChunk : ChunkSize;
+	}
+
+	inline Return InvokeAt( size_t a_Index, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		Compact();
+
+		// Nested in another dispatch the list stays uncompacted, so a_Index may name a hole.
+		if ( a_Index >= m_Invocations.size() || !m_Invocations[ a_Index ] )
+		{
+			return Return();
+		}
+
+		InvocationScope Scope( *this );
+		return DispatchAt( a_Index, FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	Return InvokeAt( DelegateHandle a_DelegateHandle, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		const size_t Index = FindHandle( a_DelegateHandle );
+
+		if ( Index == NoIndex )
+		{
+			return Return();
+		}
+
+		InvocationScope Scope( *this );
+		return DispatchAt( Index, FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	void Broadcast( FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		Arrange();
+		InvocationScope Scope( *this );
+		Dispatch( GetDispatchEnd(), FunctionTraits::Pass< Args >( a_Args )... );
+		ResumeWaiters( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	void Broadcast( std::vector< Return >& a_Output, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		Arrange();
+		a_Output.reserve( GetCount() + a_Output.size() );
+
+		InvocationScope Scope( *this );
+		Collect( a_Output, GetDispatchEnd(), FunctionTraits::Pass< Args >( a_Args )... );
+		ResumeWaiters( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	template < typename Combiner >
+	bool Combine( Combiner& a_Combiner, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		Arrange();
+		InvocationScope Scope( *this );
+		const bool IsStopped = Fold( a_Combiner, GetDispatchEnd(), FunctionTraits::Pass< Args >( a_Args )... );
+		ResumeWaiters( FunctionTraits::Pass< Args >( a_Args )... );
+		return IsStopped;
+	}
+
+	/// <summary>
+	/// Result collecting form of Dispatch.
+	/// </summary>
+	void Collect( std::vector< Return >& a_Output, size_t a_End, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		if ( m_FilterCount )
+		{
+			VisitFiltered( [ & ]( size_t i )
+			{
+				a_Output.push_back( CallAt( i, FunctionTraits::Pass< Args >( a_Args )... ) );
+				return true;
+			}, 0, a_End, GetFilterKey( FunctionTraits::Pass< Args >( a_Args )... ) );
+		}
+		else
+		{
+			for ( size_t i = 0; i < a_End; ++i )
+			{
+				if ( m_Invocations[ i ] )
+				{
+					a_Output.push_back( CallAt( i, FunctionTraits::Pass< Args >( a_Args )... ) );
+				}
+			}
+		}
+
+		if ( HasChildren() )
+		{
+			CollectChildren( a_Output, FunctionTraits::Pass< Args >( a_Args )... );
+		}
+	}
+
+	/// <summary>
+	/// Combining form of Dispatch, returns true if a_Combiner stopped it.
+	/// </summary>
+	template < typename Combiner >
+	bool Fold( Combiner& a_Combiner, size_t a_End, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		bool IsStopped = false;
+
+		if ( m_FilterCount )
+		{
+			IsStopped = !VisitFiltered( [ & ]( size_t i )
+			{
+				return a_Combiner( CallAt( i, FunctionTraits::Pass< Args >( a_Args )... ) );
+			}, 0, a_End, GetFilterKey( FunctionTraits::Pass< Args >( a_Args )... ) );
+		}
+		else
+		{
+			for ( size_t i = 0; i < a_End && !IsStopped; ++i )
+			{
+				IsStopped = m_Invocations[ i ] &&
+							!a_Combiner( CallAt( i, FunctionTraits::Pass< Args >( a_Args )... ) );
+			}
+		}
+
+		if ( !IsStopped && HasChildren() )
+		{
+			IsStopped = !FoldChildren( a_Combiner, FunctionTraits::Pass< Args >( a_Args )... );
+		}
+
+		return IsStopped;
+	}
+
+	void BroadcastParallel( FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		Arrange();
+		InvocationScope Scope( *this );
+
+		// Thread bound subscribers are sorted out on the broadcasting thread, which then runs the rest itself.
+		if ( m_AffineCount )
+		{
+			Dispatch( GetDispatchEnd(), FunctionTraits::Pass< Args >( a_Args )... );
+			ResumeWaiters( FunctionTraits::Pass< Args >( a_Args )... );
+			return;
+		}
+
+		const bool IsFiltered = m_FilterCount != 0;
+		const uint64_t Key = IsFiltered ? GetFilterKey( FunctionTraits::Pass< Args >( a_Args )... ) : 0;
+
+		auto Call = [ & ]( size_t i )
+		{
+			CallAt( i, FunctionTraits::Pass< Args >( a_Args )... );
+			return true;
+		};
+
+		auto Chunk = [ & ]( size_t a_Begin, size_t a_End )
+		{
+			if ( IsFiltered )
+			{
+				VisitFiltered( Call, a_Begin, a_End, Key );
+				return;
+			}
+
+			for ( size_t i = a_Begin; i < a_End; ++i )
+			{
+				if ( m_Invocations[ i ] )
+				{
+					Call( i );
+				}
+			}
+		};
+
+		DelegateThreadPool& Pool = DelegateThreadPool::Get();
+		Pool.ParallelFor( GetDispatchEnd(), GetParallelChunkSize( Pool ), Chunk );
+
+		// Attached delegates follow on the broadcasting thread.
+		if ( HasChildren() )
+		{
+			DispatchChildren( FunctionTraits::Pass< Args >( a_Args )... );
+		}
+
+		ResumeWaiters( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	void BroadcastParallel( std::vector< Return >& a_Output, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		Arrange();
+		Compact();
+
+		const size_t Count = GetDispatchEnd();
+
+		// Taken out for the broadcast, so a nested one gets a buffer of its own.
+		std::vector< ParallelResult > Results( std::move( m_ParallelResults ) );
+		Results.resize( Count );
+
+		// Compact waits while nested in another dispatch, so note which slots are live before any run.
+		// Filtered out subscribers count as dead for this broadcast.
+		if ( m_FilterCount )
+		{
+			for ( size_t i = 0; i < Count; ++i )
+			{
+				Results[ i ].IsLive = false;
+			}
+
+			VisitFiltered( [ & ]( size_t i )
+			{
+				Results[ i ].IsLive = true;
+				return true;
+			}, 0, Count, GetFilterKey( FunctionTraits::Pass< Args >( a_Args )... ) );
+		}
+		else
+		{
+			for ( size_t i = 0; i < Count; ++i )
+			{
+				Results[ i ].IsLive = m_Invocations[ i ] != nullptr;
+			}
+		}
+
+		InvocationScope Scope( *this );
+
+		auto Chunk = [ & ]( size_t a_Begin, size_t a_End )
+		{
+			for ( size_t i = a_Begin; i < a_End; ++i )
+			{
+				if ( Results[ i ].IsLive )
+				{
+					::new( &Results[ i ].Value ) Return( CallAt( i, FunctionTraits::Pass< Args >( a_Args )... ) );
+				}
+			}
+		};
+
+		DelegateThreadPool& Pool = DelegateThreadPool::Get();
+		Pool.ParallelFor( Count, GetParallelChunkSize( Pool ), Chunk );
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			if ( Results[ i ].IsLive )
+			{
+				Return& Result = *reinterpret_cast< Return* >( &Results[ i ].Value );
+				a_Output.push_back( std::move( Result ) );
+				Result.~Return();
+			}
+		}
+
+		m_ParallelResults = std::move( Results );
+
+		if ( HasChildren() )
+		{
+			CollectChildren( a_Output, FunctionTraits::Pass< Args >( a_Args )... );
+		}
+
+		ResumeWaiters( FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+#ifdef DELEGATE_HAS_COROUTINES
+	/// <summary>
+	/// Resumes the coroutines that were waiting when the broadcast began.
+	/// The batch is detached first, so a coroutine awaiting Next again waits
+	/// for the following broadcast.
+	/// </summary>
+	void ResumeWaiters( FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		if ( !m_Waiters.Head )
+		{
+			return;
+		}
+
+		const typename Awaiter::Arguments Arguments( FunctionTraits::Pass< Args >( a_Args )... );
+		typename Awaiter::List Batch = m_Waiters;
+		m_Waiters = typename Awaiter::List();
+
+		for ( Awaiter* Current = Batch.Head; Current; Current = Current->m_Next )
+		{
+			Current->m_List = &Batch;
+		}
+
+		while ( Awaiter* Current = Batch.Head )
+		{
+			Current->Unlink();
+			Current->m_Arguments = &Arguments;
+			Current->m_Handle.resume();
+		}
+	}
+#else
+	inline void ResumeWaiters( FunctionTraits::ForwardType< Args >... ) { }
+#endif
+
+	template < typename Event, size_t... Indices >
+	inline void ResumeUnpacked( Event& a_Event, std::index_sequence< Indices... > )
+	{
+		ResumeWaiters( FunctionTraits::Pass< Args >( std::get< Indices >( a_Event ) )... );
+	}
+
+	/// <summary>
+	/// Every subscriber call goes through here so the instrumentation policy
+	/// sees it.
+	/// </summary>
+	inline Return CallAt( size_t a_Index, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		typename Instrumentation::Scope Call( *this, m_HandleIndices[ a_Index ] );
+		return m_Invocations[ a_Index ]( m_Objects[ a_Index ], m_Functions[ a_Index ], FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	template < typename Event, size_t... Indices >
+	inline Return InvokeUnpacked( size_t a_Index, Event& a_Event, std::index_sequence< Indices... > )
+	{
+		return CallAt( a_Index, FunctionTraits::Pass< Args >( std::get< Indices >( a_Event ) )... );
+	}
+
+	/// <summary>
+	/// Calls the subscribers up to a_End with one event, then those of the
+	/// attached delegates. Delegates without thread bound or filtered
+	/// subscribers take the plain loop.
+	/// </summary>
+	inline void Dispatch( size_t a_End, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		if ( m_AffineCount )
+		{
+			DispatchAffine( std::integral_constant< bool, IsAffinable >(), a_End, FunctionTraits::Pass< Args >( a_Args )... );
+		}
+		else if ( m_FilterCount )
+		{
+			VisitFiltered( [ & ]( size_t i )
+			{
+				CallAt( i, FunctionTraits::Pass< Args >( a_Args )... );
+				return true;
+			}, 0, a_End, GetFilterKey( FunctionTraits::Pass< Args >( a_Args )... ) );
+		}
+		else
+		{
+			for ( size_t i = 0; i < a_End; ++i )
+			{
+				if ( m_Invocations[ i ] )
+				{
+					CallAt( i, FunctionTraits::Pass< Args >( a_Args )... );
+				}
+			}
+		}
+
+		if ( HasChildren() )
+		{
+			DispatchChildren( FunctionTraits::Pass< Args >( a_Args )... );
+		}
+	}
+
+	void DispatchChildren( FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		VisitChildren( [ & ]( InvocationFunction a_Invocation, void* a_Object, void* a_Function )
+		{
+			a_Invocation( a_Object, a_Function, FunctionTraits::Pass< Args >( a_Args )... );
+			return true;
+		}, [ & ]( DelegateType& a_Child )
+		{
+			a_Child.Arrange();
+			InvocationScope Scope( a_Child );
+			a_Child.Dispatch( a_Child.GetDispatchEnd(), FunctionTraits::Pass< Args >( a_Args )... );
+			return true;
+		} );
+	}
+
+	void CollectChildren( std::vector< Return >& a_Output, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		VisitChildren( [ & ]( InvocationFunction a_Invocation, void* a_Object, void* a_Function )
+		{
+			a_Output.push_back( a_Invocation( a_Object, a_Function, FunctionTraits::Pass< Args >( a_Args )... ) );
+			return true;
+		}, [ & ]( DelegateType& a_Child )
+		{
+			a_Child.Arrange();
+			InvocationScope Scope( a_Child );
+			a_Child.Collect( a_Output, a_Child.GetDispatchEnd(), FunctionTraits::Pass< Args >( a_Args )... );
+			return true;
+		} );
+	}
+
+	template < typename Combiner >
+	bool FoldChildren( Combiner& a_Combiner, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		return VisitChildren( [ & ]( InvocationFunction a_Invocation, void* a_Object, void* a_Function )
+		{
+			return a_Combiner( a_Invocation( a_Object, a_Function, FunctionTraits::Pass< Args >( a_Args )... ) );
+		}, [ & ]( DelegateType& a_Child )
+		{
+			a_Child.Arrange();
+			InvocationScope Scope( a_Child );
+			return !a_Child.Fold( a_Combiner, a_Child.GetDispatchEnd(), FunctionTraits::Pass< Args >( a_Args )... );
+		} );
+	}
+
+	template < typename Event, size_t... Indices >
+	inline void DispatchUnpacked( size_t a_End, Event& a_Event, std::index_sequence< Indices... > )
+	{
+		Dispatch( a_End, FunctionTraits::Pass< Args >( std::get< Indices >( a_Event ) )... );
+	}
+
+	inline void DispatchAffine( std::false_type, size_t, FunctionTraits::ForwardType< Args >... ) { }
+
+	/// <summary>
+	/// Subscribers bound to the calling thread's executor run in place like
+	/// unbound ones. The rest are collected into one post per executor,
+	/// all sent once the pass is over.
+	/// </summary>
+	void DispatchAffine( std::true_type, size_t a_End, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		const std::thread::id Current = std::this_thread::get_id();
+		AffinePost* Posts = nullptr;
+
+		auto Visit = [ & ]( size_t i )
+		{
+			Affinity* Target = m_Affinities[ i ];
+
+			if ( !Target || Target->Executor->GetOwner() == Current )
+			{
+				CallAt( i, FunctionTraits::Pass< Args >( a_Args )... );
+				return true;
+			}
+
+			AffinePost* Post = Posts;
+
+			while ( Post && Post->Executor != Target->Executor )
+			{
+				Post = static_cast< AffinePost* >( Post->Next );
+			}
+
+			if ( !Post )
+			{
+				Post = AffinePost::Create( Target->Executor, m_AffineCount, FunctionTraits::Pass< Args >( a_Args )... );
+				Post->Next = Posts;
+				Posts = Post;
+			}
+
+			Post->Add( Target );
+			return true;
+		};
+
+		if ( m_FilterCount )
+		{
+			VisitFiltered( Visit, 0, a_End, GetFilterKey( FunctionTraits::Pass< Args >( a_Args )... ) );
+		}
+		else
+		{
+			for ( size_t i = 0; i < a_End; ++i )
+			{
+				if ( m_Invocations[ i ] )
+				{
+					Visit( i );
+				}
+			}
+		}
+
+		while ( Posts )
+		{
+			AffinePost* Next = static_cast< AffinePost* >( Posts->Next );
+			Posts->Executor->Post( Posts );
+			Posts = Next;
+		}
+	}
+
+	/// <summary>
+	/// Single target form of Dispatch, a foreign thread bound subscriber
+	/// gets a post of its own.
+	/// </summary>
+	inline Return DispatchAt( size_t a_Index, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		Affinity* Target = m_Affinities[ a_Index ];
+
+		if ( Target && !Target->Executor->IsCurrent() )
+		{
+			PostAt( std::integral_constant< bool, IsAffinable >(), *Target, FunctionTraits::Pass< Args >( a_Args )... );
+			return Return();
+		}
+
+		return CallAt( a_Index, FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	inline void PostAt( std::false_type, Affinity&, FunctionTraits::ForwardType< Args >... ) { }
+
+	void PostAt( std::true_type, Affinity& a_Target, FunctionTraits::ForwardType< Args >... a_Args )
+	{
+		AffinePost* Post = AffinePost::Create( a_Target.Executor, 1, FunctionTraits::Pass< Args >( a_Args )... );
+		Post->Add( &a_Target );
+		a_Target.Executor->Post( Post );
+	}
+
+	/// <summary>
+	/// Binds the subscriber at a_Index to a_Executor. Its lambda state,
+	/// if any, stays where Emplace put it, the affinity only points at it.
+	/// </summary>
+	void BindAt( size_t a_Index, DelegateExecutor& a_Executor )
+	{
+		m_Affinities[ a_Index ] = new Affinity( a_Executor, m_Invocations[ a_Index ], m_Objects[ a_Index ], m_Functions[ a_Index ] );
+		++m_AffineCount;
+		Touch();
+	}
+
+	std::vector< DelegateExecutor* > GetExecutors() const
+	{
+		std::vector< DelegateExecutor* > Result;
+		Result.reserve( GetCount() );
+
+		for ( size_t i = 0; i < m_Invocations.size(); ++i )
+		{
+			if ( m_Invocations[ i ] )
+			{
+				Result.push_back( m_Affinities[ i ] ? m_Affinities[ i ]->Executor : nullptr );
+			}
+		}
+
+		return Result;
+	}
+
+	/// <summary>
+	/// Calls a_Visit with every live subscriber in [ a_Begin, a_End ) whose
+	/// filter accepts a_Key, in order, until it returns false. The filters
+	/// of 64 subscribers are evaluated together, so only the matches cost
+	/// a call.
+	/// </summary>
+	template < typename Visit >
+	bool VisitFiltered( Visit&& a_Visit, size_t a_Begin, size_t a_End, uint64_t a_Key )
+	{
+		for ( size_t Block = a_Begin; Block < a_End; Block += 64 )
+		{
+			const size_t Count = a_End - Block < 64 ? a_End - Block : 64;
+			uint64_t Matches = MatchFilterKeys( &m_FilterKeys[ Block ], &m_IsFiltered[ Block ], Count, a_Key );
+
+			for ( ; Matches; Matches &= Matches - 1 )
+			{
+				const size_t i = Block + CountTrailingZeros( Matches );
+
+				if ( m_Invocations[ i ] && !a_Visit( i ) )
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	inline uint64_t GetFilterKey( FunctionTraits::ForwardType< Args >... a_Args ) const
+	{
+		return m_Projection.Extract( &m_Projection.Storage, FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	/// <summary>
+	/// A delegate's filters all read the same key. The first filter picks
+	/// the projection, later ones must match it while any filter is left.
+	/// </summary>
+	bool UseProjection( const KeyProjection& a_Projection )
+	{
+		if ( m_FilterCount && ( m_Projection.Extract != a_Projection.Extract || !m_Projection.Equals( &m_Projection.Storage, &a_Projection.Storage ) ) )
+		{
+			return false;
+		}
+
+		m_Projection = a_Projection;
+		return true;
+	}
+
+	template < size_t Index, typename Projection >
+	bool UseProjection( const Projection& a_Projection )
+	{
+		static_assert( sizeof( Projection ) <= sizeof( typename KeyProjection::Buffer ) && std::is_trivially_copyable< Projection >::value, "Filters project through a data member or a getter." );
+
+		KeyProjection Candidate;
+		Candidate.Extract = &DelegateType::template ExtractKey< Index, Projection >;
+		Candidate.Equals = &DelegateType::template EqualProjections< Projection >;
+		::new( &Candidate.Storage ) Projection( a_Projection );
+		return UseProjection( Candidate );
+	}
+
+	inline void FilterAt( size_t a_Index, uint64_t a_Key )
+	{
+		m_FilterKeys[ a_Index ] = a_Key;
+		m_IsFiltered[ a_Index ] = 1;
+		++m_FilterCount;
+		Touch();
+	}
+
+	/// <summary>
+	/// Filter key and whether it applies for each live subscriber, in order.
+	/// </summary>
+	std::vector< std::pair< uint64_t, bool > > GetFilters() const
+	{
+		std::vector< std::pair< uint64_t, bool > > Result;
+		Result.reserve( GetCount() );
+
+		for ( size_t i = 0; i < m_Invocations.size(); ++i )
+		{
+			if ( m_Invocations[ i ] )
+			{
+				Result.emplace_back( m_FilterKeys[ i ], m_IsFiltered[ i ] != 0 );
+			}
+		}
+
+		return Result;
+	}
+
+	inline InvokerType GetInvoker( size_t a_Index ) const
+	{
+		InvokerType Result;
+		Result.m_Invocation = m_Invocations[ a_Index ];
+		Result.m_Object     = m_Objects[ a_Index ];
+		Result.m_Function   = m_Functions[ a_Index ];
+		Result.m_Manager    = m_Managers[ a_Index ];
+
+		if ( Result.m_Manager )
+		{
+			void*& Owned = Result.GetOwned();
+			Owned = Result.m_Manager( LambdaOperation::Copy, Result.m_Buffer, Owned );
+		}
+
+		return Result;
+	}
+
+	/// <summary>
+	/// Earliest subscriber equal to a_Invoker. Only the chain of its most
+	/// selective key is walked: the target object, else the function, else
+	/// the thunk for owned lambdas.
+	/// </summary>
+	size_t FindInvoker( const InvokerType& a_Invoker ) const
+	{
+		if ( a_Invoker.IsLambda() || ( !a_Invoker.m_Object && !a_Invoker.m_Function ) )
+		{
+			return FindInvoker( a_Invoker, m_ByInvocation, m_ByInvocation.GetFirst( a_Invoker.m_Invocation ) );
+		}
+
+		return a_Invoker.m_Object ? FindInvoker( a_Invoker, m_ByObject, m_ByObject.GetFirst( a_Invoker.m_Object ) )
+								  : FindInvoker( a_Invoker, m_ByFunction, m_ByFunction.GetFirst( GetFunctionKey( a_Invoker.m_Function, a_Invoker.m_Manager ) ) );
+	}
+
+	template < typename Key >
+	size_t FindInvoker( const InvokerType& a_Invoker, const StorageIndex< Key >& a_Index, uint32_t a_Slot ) const
+	{
+		size_t Result = NoIndex;
+
+		for ( ; a_Slot != StorageIndex< Key >::NoSlot; a_Slot = a_Index.GetNext( a_Slot ) )
+		{
+			const size_t i = m_Handles[ a_Slot ].Index;
+
+			if ( i < Result && InvokerType::IsSame( a_Invoker, m_Invocations[ i ], m_Objects[ i ], m_Functions[ i ], m_Managers[ i ] ) )
+			{
+				Result = i;
+			}
+		}
+
+		return Result;
+	}
+
+	/// <summary>
+	/// Removes every subscriber on a chain.
+	/// </summary>
+	template < typename Key >
+	bool RemoveChain( StorageIndex< Key >& a_Index, uint32_t a_Slot )
+	{
+		return RemoveChain( a_Index, a_Slot, []( size_t ) { return true; } );
+	}
+
+	/// <summary>
+	/// Removes the subscribers on a chain that a_Match accepts.
+	/// </summary>
+	template < typename Key, typename Match >
+	bool RemoveChain( StorageIndex< Key >& a_Index, uint32_t a_Slot, Match a_Match )
+	{
+		bool IsFound = false;
+
+		while ( a_Slot != StorageIndex< Key >::NoSlot )
+		{
+			// Erase unlinks the slot, so step off it first.
+			const uint32_t Next = a_Index.GetNext( a_Slot );
+			const size_t Index = m_Handles[ a_Slot ].Index;
+
+			if ( a_Match( Index ) )
+			{
+				Erase( Index );
+				IsFound = true;
+			}
+
+			a_Slot = Next;
+		}
+
+		return IsFound;
+	}
+
+	inline bool IsOwnedLambda( size_t a_Index ) const { return m_Managers[ a_Index ] && !m_Functions[ a_Index ]; }
+
+	/// <summary>
+	/// Every member subscriber holds its own copy of the member function
+	/// pointer, so those are keyed by a hash of its value and told apart
+	/// by comparing the pointers. Free functions are their own key, owned
+	/// lambdas have none.
+	/// </summary>
+	static inline void* GetFunctionKey( void* a_Function, LambdaManager a_Manager )
+	{
+		return a_Manager && a_Function ? a_Manager( LambdaOperation::Hash, nullptr, a_Function ) : a_Function;
+	}
+
+	inline void* GetFunctionKey( size_t a_Index ) const
+	{
+		return GetFunctionKey( m_Functions[ a_Index ], m_Managers[ a_Index ] );
+	}
+
+	inline void LinkIndices( size_t a_Index, uint32_t a_Slot )
+	{
+		// An owned lambda's object is private pool storage nobody can name, so only the thunk is indexed.
+		if ( m_Objects[ a_Index ] && !IsOwnedLambda( a_Index ) )
+		{
+			m_ByObject.Link( m_Objects[ a_Index ], a_Slot );
+		}
+
+		if ( m_Functions[ a_Index ] )
+		{
+			m_ByFunction.Link( GetFunctionKey( a_Index ), a_Slot );
+		}
+
+		m_ByInvocation.Link( m_Invocations[ a_Index ], a_Slot );
+	}
+
+	inline void UnlinkIndices( size_t a_Index, uint32_t a_Slot )
+	{
+		if ( m_Objects[ a_Index ] && !IsOwnedLambda( a_Index ) )
+		{
+			m_ByObject.Unlink( m_Objects[ a_Index ], a_Slot );
+		}
+
+		if ( m_Functions[ a_Index ] )
+		{
+			m_ByFunction.Unlink( GetFunctionKey( a_Index ), a_Slot );
+		}
+
+		m_ByInvocation.Unlink( m_Invocations[ a_Index ], a_Slot );
+	}
+
+	inline size_t FindHandle( DelegateHandle a_DelegateHandle ) const
+	{
+		if ( a_DelegateHandle.m_Index >= m_Handles.size() )
+		{
+			return NoIndex;
+		}
+
+		const HandleSlot& Slot = m_Handles[ a_DelegateHandle.m_Index ];
+		return Slot.Generation == a_DelegateHandle.m_Generation ? Slot.Index : NoIndex;
+	}
+
+	using StatisticsTable = typename Instrumentation::Table;
+
+	inline StatisticsTable& Statistics() { return *this; }
+	inline const StatisticsTable& Statistics() const { return *this; }
+
+	DelegateHandle AcquireHandle( size_t a_Index )
+	{
+		uint32_t Slot = m_FreeHandle;
+
+		if ( Slot == NoHandle )
+		{
+			Slot = static_cast< uint32_t >( m_Handles.size() );
+			m_Handles.push_back( { 0, 1 } );
+		}
+		else
+		{
+			m_FreeHandle = m_Handles[ Slot ].Index;
+		}
+
+		m_Handles[ Slot ].Index = static_cast< uint32_t >( a_Index );
+		Statistics().ResetSlot( Slot );
+		return DelegateHandle( Slot, m_Handles[ Slot ].Generation );
+	}
+
+	void ReleaseHandle( uint32_t a_Slot )
+	{
+		HandleSlot& Slot = m_Handles[ a_Slot ];
+
+		// Generation zero is reserved for the default constructed handle.
+		if ( ++Slot.Generation == 0 )
+		{
+			Slot.Generation = 1;
+		}
+
+		Slot.Index = m_FreeHandle;
+		m_FreeHandle = a_Slot;
+	}
+
+	/// <summary>
+	/// Inserts at a_Index with a_Priority clamped between its neighbours',
+	/// so positional inserts never break the priority order. While invoking
+	/// the subscriber is staged at the end instead and only keeps the
+	/// clamped priority, Settle merges it in behind its equals. A deferred
+	/// insert that is not an append is staged the same way outside a
+	/// dispatch, so a run of priority adds is merged in one pass.
+	/// </summary>
+	DelegateHandle Emplace( size_t a_Index, const InvokerType& a_Invoker, int32_t a_Priority = 0, bool a_Deferred = false )
+	{
+		if ( !a_Invoker.IsSet() || a_Index > m_Invocations.size() )
+		{
+			return DelegateHandle();
+		}
+
+		// Positional inserts shift the staged block, so it has to be merged first.
+		if ( !a_Deferred )
+		{
+			MergePending();
+		}
+
+		const int32_t Priority = ClampPriority( a_Index, a_Priority );
+
+		if ( m_InvokeDepth || ( a_Deferred && a_Index != m_Invocations.size() ) )
+		{
+			a_Index = m_Invocations.size();
+			m_StagedBegin = m_StagedBegin == NoIndex ? a_Index : m_StagedBegin;
+		}
+
+		// Owned state is copied into the LambdaPool so its address survives the arrays growing.
+		void* Object = a_Invoker.m_Object;
+		void* Function = a_Invoker.m_Function;
+
+		if ( a_Invoker.m_Manager )
+		{
+			void*& Owned = Function ? Function : Object;
+			Owned = a_Invoker.m_Manager( LambdaOperation::Copy, nullptr, Owned );
+		}
+
+		const DelegateHandle Handle = AcquireHandle( a_Index );
+		m_Invocations  .insert( m_Invocations  .begin() + a_Index, a_Invoker.m_Invocation );
+		m_Objects      .insert( m_Objects      .begin() + a_Index, Object );
+		m_Functions    .insert( m_Functions    .begin() + a_Index, Function );
+		m_Managers     .insert( m_Managers     .begin() + a_Index, a_Invoker.m_Manager );
+		m_Priorities   .insert( m_Priorities   .begin() + a_Index, Priority );
+		m_Affinities   .insert( m_Affinities   .begin() + a_Index, nullptr );
+		m_FilterKeys   .insert( m_FilterKeys   .begin() + a_Index, 0 );
+		m_IsFiltered   .insert( m_IsFiltered   .begin() + a_Index, 0 );
+		m_HandleIndices.insert( m_HandleIndices.begin() + a_Index, Handle.m_Index );
+		LinkIndices( a_Index, Handle.m_Index );
+
+		// Room to tombstone every entry, so Erase allocates nothing while invoking.
+		if ( m_Tombstones.capacity() < m_Invocations.size() )
+		{
+			m_Tombstones.reserve( m_Invocations.capacity() );
+		}
+
+		// Appending leaves the grouped prefix intact for Group to merge into.
+		if ( a_Index < m_GroupedEnd )
+		{
+			m_GroupedEnd = 0;
+		}
+
+		for ( size_t i = a_Index + 1; i < m_HandleIndices.size(); ++i )
+		{
+			if ( m_Invocations[ i ] )
+			{
+				m_Handles[ m_HandleIndices[ i ] ].Index = static_cast< uint32_t >( i );
+			}
+		}
+
+		Touch();
+		return Handle;
+	}
+
+	void InsertAt( size_t a_Index, const DelegateType& a_Delegate )
+	{
+		// Copy out first, inserting a delegate into itself would otherwise read shifted slots.
+		const std::vector< InvokerType > Invokers = a_Delegate.GetInvocationList();
+		const std::vector< int32_t > Priorities = a_Delegate.GetPriorities();
+		const std::vector< DelegateExecutor* > Executors = a_Delegate.GetExecutors();
+		const std::vector< std::pair< uint64_t, bool > > Filters = a_Delegate.GetFilters();
+		const KeyProjection Projection = a_Delegate.m_Projection;
+
+		for ( size_t i = 0; i < Invokers.size(); ++i )
+		{
+			if ( Filters[ i ].second && !UseProjection( Projection ) )
+			{
+				continue;
+			}
+
+			const DelegateHandle Handle = Emplace( a_Index + i, Invokers[ i ], Priorities[ i ] );
+			AdoptAt( Handle, Executors[ i ], Filters[ i ] );
+		}
+	}
+
+	/// <summary>
+	/// Adds every subscriber of a_Delegate at its own priority, thread
+	/// affinity and filter, keeping their relative order. Filtered ones are
+	/// skipped if this delegate's filters project another key.
+	/// </summary>
+	void Merge( const DelegateType& a_Delegate )
+	{
+		const std::vector< InvokerType > Invokers = a_Delegate.GetInvocationList();
+		const std::vector< int32_t > Priorities = a_Delegate.GetPriorities();
+		const std::vector< DelegateExecutor* > Executors = a_Delegate.GetExecutors();
+		const std::vector< std::pair< uint64_t, bool > > Filters = a_Delegate.GetFilters();
+		const KeyProjection Projection = a_Delegate.m_Projection;
+
+		for ( size_t i = 0; i < Invokers.size(); ++i )
+		{
+			if ( Filters[ i ].second && !UseProjection( Projection ) )
+			{
+				continue;
+			}
+
+			const DelegateHandle Handle = Add( Priorities[ i ], Invokers[ i ] );
+			AdoptAt( Handle, Executors[ i ], Filters[ i ] );
+		}
+	}
+
+	/// <summary>
+	/// Gives a subscriber copied from another delegate the executor and
+	/// filter it had there.
+	/// </summary>
+	inline void AdoptAt( DelegateHandle a_DelegateHandle, DelegateExecutor* a_Executor, const std::pair< uint64_t, bool >& a_Filter )
+	{
+		if ( !a_DelegateHandle.IsValid() )
+		{
+			return;
+		}
+
+		const size_t Index = FindHandle( a_DelegateHandle );
+
+		if ( a_Executor )
+		{
+			BindAt( Index, *a_Executor );
+		}
+
+		if ( a_Filter.second )
+		{
+			FilterAt( Index, a_Filter.first );
+		}
+	}
+
+	std::vector< int32_t > GetPriorities() const
+	{
+		std::vector< int32_t > Result;
+		Result.reserve( GetCount() );
+
+		for ( size_t i = 0; i < m_Invocations.size(); ++i )
+		{
+			if ( m_Invocations[ i ] )
+			{
+				Result.push_back( m_Priorities[ i ] );
+			}
+		}
+
+		return Result;
+	}
+
+	/// <summary>
+	/// First index behind every subscriber of a_Priority or higher. Holes
+	/// keep their priority, so the array stays sorted and searchable up to
+	/// the staged subscribers.
+	/// </summary>
+	inline size_t FindPriorityIndex( int32_t a_Priority ) const
+	{
+		const size_t End = GetDispatchEnd();
+
+		if ( End == 0 || m_Priorities[ End - 1 ] >= a_Priority )
+		{
+			return End;
+		}
+
+		return std::upper_bound( m_Priorities.begin(), m_Priorities.begin() + End, a_Priority, std::greater< int32_t >() ) - m_Priorities.begin();
+	}
+
+	inline int32_t ClampPriority( size_t a_Index, int32_t a_Priority ) const
+	{
+		const size_t End = GetDispatchEnd();
+		a_Index = a_Index < End ? a_Index : End;
+
+		if ( a_Index < End && a_Priority < m_Priorities[ a_Index ] )
+		{
+			return m_Priorities[ a_Index ];
+		}
+
+		if ( a_Index > 0 && a_Priority > m_Priorities[ a_Index - 1 ] )
+		{
+			return m_Priorities[ a_Index - 1 ];
+		}
+
+		return a_Priority;
+	}
+
+	bool RemoveAt( size_t a_Index )
+	{
+		if ( a_Index >= m_Invocations.size() || !m_Invocations[ a_Index ] )
+		{
+			return false;
+		}
+
+		Erase( a_Index );
+		return true;
+	}
+
+	/// <summary>
+	/// Releases the subscriber's handle and leaves a hole in the packed
+	/// arrays. Holes are skipped by dispatch and squeezed out by Compact
+	/// once they make up half of the list. While invoking the hole is a
+	/// tombstone that still owns its lambda state, since the subscriber may
+	/// be the one running. Calls already posted to another thread for it
+	/// are dropped.
+	/// </summary>
+	void Erase( size_t a_Index )
+	{
+		UnlinkIndices( a_Index, m_HandleIndices[ a_Index ] );
+		ReleaseHandle( m_HandleIndices[ a_Index ] );
+		Touch();
+
+		if ( m_Affinities[ a_Index ] )
+		{
+			m_Affinities[ a_Index ]->IsConnected.store( false, std::memory_order_release );
+			--m_AffineCount;
+		}
+
+		if ( m_IsFiltered[ a_Index ] )
+		{
+			m_IsFiltered[ a_Index ] = 0;
+			--m_FilterCount;
+		}
+
+		if ( m_InvokeDepth )
+		{
+			// A tombstone keeps the owned state in m_Objects or m_Functions until Settle.
+			if ( m_Managers[ a_Index ] || m_Affinities[ a_Index ] )
+			{
+				m_Tombstones.push_back( static_cast< uint32_t >( a_Index ) );
+			}
+			else
+			{
+				m_Functions[ a_Index ] = nullptr;
+			}
+
+			m_Invocations[ a_Index ] = nullptr;
+			++m_Holes;
+			return;
+		}
+
+		ReleaseState( a_Index );
+		m_Invocations[ a_Index ] = nullptr;
+		m_Objects[ a_Index ] = nullptr;
+		m_Functions[ a_Index ] = nullptr;
+		m_Managers[ a_Index ] = nullptr;
+		++m_Holes;
+
+		if ( m_Holes * 2 >= m_Invocations.size() )
+		{
+			Compact();
+		}
+	}
+
+	/// <summary>
+	/// Squeezes the holes out of the packed arrays. Waits while invoking,
+	/// dispatch loops index the arrays directly.
+	/// </summary>
+	void Compact()
+	{
+		MergePending();
+
+		if ( !m_Holes || m_InvokeDepth )
+		{
+			return;
+		}
+
+		size_t Write = 0;
+		size_t GroupedEnd = 0;
+
+		for ( size_t Read = 0; Read < m_Invocations.size(); ++Read )
+		{
+			if ( !m_Invocations[ Read ] )
+			{
+				continue;
+			}
+
+			GroupedEnd = Read < m_GroupedEnd ? Write + 1 : GroupedEnd;
+
+			m_Invocations[ Write ]   = m_Invocations[ Read ];
+			m_Objects[ Write ]       = m_Objects[ Read ];
+			m_Functions[ Write ]     = m_Functions[ Read ];
+			m_Managers[ Write ]      = m_Managers[ Read ];
+			m_Priorities[ Write ]    = m_Priorities[ Read ];
+			m_Affinities[ Write ]    = m_Affinities[ Read ];
+			m_FilterKeys[ Write ]    = m_FilterKeys[ Read ];
+			m_IsFiltered[ Write ]    = m_IsFiltered[ Read ];
+			m_HandleIndices[ Write ] = m_HandleIndices[ Read ];
+			m_Handles[ m_HandleIndices[ Write ] ].Index = static_cast< uint32_t >( Write );
+			++Write;
+		}
+
+		m_Invocations.resize( Write );
+		m_Objects.resize( Write );
+		m_Functions.resize( Write );
+		m_Managers.resize( Write );
+		m_Priorities.resize( Write );
+		m_Affinities.resize( Write );
+		m_FilterKeys.resize( Write );
+		m_IsFiltered.resize( Write );
+		m_HandleIndices.resize( Write );
+		m_Holes = 0;
+		m_GroupedEnd = GroupedEnd;
+		Touch();
+	}
+
+	/// <summary>
+	/// Runs when the outermost dispatch returns, however many nested
+	/// dispatches left work behind. Tombstones release their lambda state
+	/// and become plain holes, staged subscribers are merged into priority
+	/// order, and the usual hole threshold decides on a compaction pass.
+	/// </summary>
+	void Settle()
+	{
+		for ( size_t i = 0; i < m_Tombstones.size(); ++i )
+		{
+			const uint32_t Index = m_Tombstones[ i ];
+			ReleaseState( Index );
+			m_Managers[ Index ] = nullptr;
+			m_Objects[ Index ] = nullptr;
+			m_Functions[ Index ] = nullptr;
+		}
+
+		m_Tombstones.clear();
+		MergePending();
+
+		if ( m_Holes * 2 >= m_Invocations.size() )
+		{
+			Compact();
+		}
+	}
+
+	/// <summary>
+	/// Merges the staged subscribers unless a dispatch still walks the
+	/// arrays. Anything that reads positions or the dispatch order runs
+	/// this first.
+	/// </summary>
+	inline void MergePending()
+	{
+		if ( m_StagedBegin != NoIndex && !m_InvokeDepth )
+		{
+			const size_t Begin = m_StagedBegin;
+			m_StagedBegin = NoIndex;
+			MergeStaged( Begin );
+			Touch();
+		}
+	}
+
+	/// <summary>
+	/// Staged subscribers are in the order they were added. When their
+	/// priorities already continue the sorted prefix they stay where they
+	/// are, otherwise they are stable merged in behind their equals. An
+	/// unordered delegate whose prefix is grouped merges them by the
+	/// grouping instead, which keeps the priority order as well.
+	/// </summary>
+	void MergeStaged( size_t a_Begin )
+	{
+		if ( std::is_sorted( m_Priorities.begin() + ( a_Begin ? a_Begin - 1 : 0 ), m_Priorities.end(), std::greater< int32_t >() ) )
+		{
+			return;
+		}
+
+		if ( m_Ordering == DelegateOrdering::Unordered && m_GroupedEnd >= a_Begin )
+		{
+			Group();
+			return;
+		}
+
+		MergeTail( a_Begin, [ this ]( uint32_t a_Left, uint32_t a_Right )
+		{
+			return m_Priorities[ a_Left ] > m_Priorities[ a_Right ];
+		} );
+
+		m_GroupedEnd = 0;
+	}
+
+	/// <summary>
+	/// Puts the arrays in dispatch order before a dispatch walks them.
+	/// </summary>
+	inline void Arrange()
+	{
+		MergePending();
+
+		if ( m_Ordering == DelegateOrdering::Unordered && m_GroupedEnd != m_Invocations.size() && !m_InvokeDepth )
+		{
+			Group();
+		}
+	}
+
+	/// <summary>
+	/// Stable sorts the packed arrays by invocation thunk and then target
+	/// within each priority, so subscribers sharing both sit next to each
+	/// other without reordering across priorities. Only the subscribers
+	/// added since the last call are sorted, then merged into the rest.
+	/// </summary>
+	void Group()
+	{
+		Compact();
+
+		MergeTail( m_GroupedEnd, [ this ]( uint32_t a_Left, uint32_t a_Right )
+		{
+			if ( m_Priorities[ a_Left ] != m_Priorities[ a_Right ] )
+			{
+				return m_Priorities[ a_Left ] > m_Priorities[ a_Right ];
+			}
+
+			if ( m_Invocations[ a_Left ] != m_Invocations[ a_Right ] )
+			{
+				return std::less< InvocationFunction >()( m_Invocations[ a_Left ], m_Invocations[ a_Right ] );
+			}
+
+			return std::less< void* >()( GetFunctionKey( a_Left ), GetFunctionKey( a_Right ) );
+		} );
+
+		m_GroupedEnd = m_Invocations.size();
+	}
+
+	/// <summary>
+	/// Stable sorts the subscribers from a_Begin on and merges them into
+	/// the ones before, which must already be sorted by a_Less.
+	/// </summary>
+	template < typename Less >
+	void MergeTail( size_t a_Begin, Less a_Less )
+	{
+		StorageVector< uint32_t > Order( m_Invocations.size() );
+
+		for ( size_t i = 0; i < Order.size(); ++i )
+		{
+			Order[ i ] = static_cast< uint32_t >( i );
+		}
+
+		std::stable_sort( Order.begin() + a_Begin, Order.end(), a_Less );
+		std::inplace_merge( Order.begin(), Order.begin() + a_Begin, Order.end(), a_Less );
+		Reorder( Order );
+	}
+
+	/// <summary>
+	/// Moves the subscriber at a_Order[ i ] to index i in every packed
+	/// array and repoints the live handles.
+	/// </summary>
+	void Reorder( const StorageVector< uint32_t >& a_Order )
+	{
+		Permute( m_Invocations, a_Order );
+		Permute( m_Objects, a_Order );
+		Permute( m_Functions, a_Order );
+		Permute( m_Managers, a_Order );
+		Permute( m_Priorities, a_Order );
+		Permute( m_Affinities, a_Order );
+		Permute( m_FilterKeys, a_Order );
+		Permute( m_IsFiltered, a_Order );
+		Permute( m_HandleIndices, a_Order );
+
+		for ( size_t i = 0; i < m_HandleIndices.size(); ++i )
+		{
+			if ( m_Invocations[ i ] )
+			{
+				m_Handles[ m_HandleIndices[ i ] ].Index = static_cast< uint32_t >( i );
+			}
+		}
+
+		Touch();
+	}
+
+	/// <summary>
+	/// Delegates attached to this one and those it is attached to, with
+	/// the flattened subscribers of everything attached below it. Version
+	/// moves whenever this delegate or one below it changes, the flat
+	/// arrays are current while FlatVersion matches it. An attached
+	/// delegate that must sort its subscribers out per event is kept as a
+	/// single entry without an invocation, and dispatches itself.
+	/// </summary>
+	struct Composition
+	{
+		Composition()
+			: Version( 1 )
+			, FlatVersion( 0 )
+			, Depth( 0 )
+		{ }
+
+		StorageVector< DelegateType* >      Children;
+		StorageVector< DelegateType* >      Parents;
+		StorageVector< InvocationFunction > Invocations;
+		StorageVector< void* >              Objects;
+		StorageVector< void* >              Functions;
+		StorageVector< DelegateType* >      Owners;
+		StorageVector< uint32_t >           Indices;
+		StorageVector< DelegateType* >      Members;
+		uint64_t                            Version;
+		uint64_t                            FlatVersion;
+		uint32_t                            Depth;
+	};
+
+	/// <summary>
+	/// Holds an invoking section open on every flattened delegate for a
+	/// pass over the flat arrays, so their lambda state and indices stay
+	/// put whatever the subscribers do.
+	/// </summary>
+	struct CompositionScope
+	{
+		CompositionScope( Composition& a_Tree )
+			: m_Tree( a_Tree )
+		{
+			++m_Tree.Depth;
+
+			for ( size_t i = 0; i < m_Tree.Members.size(); ++i )
+			{
+				if ( m_Tree.Members[ i ] )
+				{
+					++m_Tree.Members[ i ]->m_InvokeDepth;
+				}
+			}
+		}
+
+		~CompositionScope()
+		{
+			for ( size_t i = 0; i < m_Tree.Members.size(); ++i )
+			{
+				if ( m_Tree.Members[ i ] && --m_Tree.Members[ i ]->m_InvokeDepth == 0 )
+				{
+					m_Tree.Members[ i ]->Settle();
+				}
+			}
+
+			--m_Tree.Depth;
+		}
+
+		Composition& m_Tree;
+	};
+
+	/// <summary>
+	/// Instrumented calls are recorded per slot of the delegate that owns
+	/// them, so instrumented delegates always dispatch themselves.
+	/// </summary>
+	static constexpr bool IsFlattenable = std::is_same< Instrumentation, NullInstrumentation >::value;
+
+	inline Composition& Compose()
+	{
+		if ( !m_Composition )
+		{
+			m_Composition.reset( new Composition() );
+		}
+
+		return *m_Composition;
+	}
+
+	inline bool HasChildren() const { return m_Composition && !m_Composition->Children.empty(); }
+
+	inline void Touch()
+	{
+		if ( m_Composition )
+		{
+			Invalidate();
+		}
+	}
+
+	void Invalidate()
+	{
+		++m_Composition->Version;
+
+		for ( size_t i = 0; i < m_Composition->Parents.size(); ++i )
+		{
+			m_Composition->Parents[ i ]->Invalidate();
+		}
+	}
+
+	bool Reaches( const DelegateType& a_Target ) const
+	{
+		if ( this == &a_Target )
+		{
+			return true;
+		}
+
+		for ( size_t i = 0; m_Composition && i < m_Composition->Children.size(); ++i )
+		{
+			if ( m_Composition->Children[ i ]->Reaches( a_Target ) )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline void Unparent( DelegateType& a_Parent )
+	{
+		StorageVector< DelegateType* >& Parents = m_Composition->Parents;
+		Parents.erase( std::find( Parents.begin(), Parents.end(), &a_Parent ) );
+	}
+
+	/// <summary>
+	/// Takes a_Member and what is attached below it out of the passes
+	/// running over the flat arrays of this delegate and those above it,
+	/// before it is detached or destroyed. Its entries are skipped for the
+	/// rest of each pass and the invoking sections held on it are closed.
+	/// </summary>
+	void Withdraw( DelegateType& a_Member )
+	{
+		Composition& Tree = *m_Composition;
+
+		if ( Tree.Depth )
+		{
+			WithdrawFrom( Tree, a_Member );
+		}
+
+		for ( size_t i = 0; i < Tree.Parents.size(); ++i )
+		{
+			Tree.Parents[ i ]->Withdraw( a_Member );
+		}
+	}
+
+	static void WithdrawFrom( Composition& a_Tree, DelegateType& a_Member )
+	{
+		for ( size_t i = 0; i < a_Tree.Owners.size(); ++i )
+		{
+			if ( a_Tree.Owners[ i ] == &a_Member )
+			{
+				a_Tree.Invocations[ i ] = nullptr;
+				a_Tree.Owners[ i ] = nullptr;
+			}
+		}
+
+		for ( size_t i = 0; i < a_Tree.Members.size(); ++i )
+		{
+			if ( a_Tree.Members[ i ] == &a_Member )
+			{
+				a_Tree.Members[ i ] = nullptr;
+
+				// Every running pass over a_Tree holds one invoking section per entry.
+				if ( ( a_Member.m_InvokeDepth -= a_Tree.Depth ) == 0 )
+				{
+					a_Member.Settle();
+				}
+			}
+		}
+
+		for ( size_t i = 0; a_Member.m_Composition && i < a_Member.m_Composition->Children.size(); ++i )
+		{
+			WithdrawFrom( a_Tree, *a_Member.m_Composition->Children[ i ] );
+		}
+	}
+
+	void DetachComposition()
+	{
+		if ( !m_Composition )
+		{
+			return;
+		}
+
+		for ( size_t i = 0; i < m_Composition->Parents.size(); ++i )
+		{
+			m_Composition->Parents[ i ]->Withdraw( *this );
+		}
+
+		for ( size_t i = 0; i < m_Composition->Parents.size(); ++i )
+		{
+			DelegateType& Parent = *m_Composition->Parents[ i ];
+			StorageVector< DelegateType* >& Siblings = Parent.m_Composition->Children;
+			Siblings.erase( std::find( Siblings.begin(), Siblings.end(), this ) );
+			Parent.Invalidate();
+		}
+
+		for ( size_t i = 0; i < m_Composition->Children.size(); ++i )
+		{
+			m_Composition->Children[ i ]->Unparent( *this );
+		}
+
+		m_Composition.reset();
+	}
+
+	/// <summary>
+	/// Points the delegates on either side of a moved composition at its
+	/// new owner. The flat arrays of those above named the old one.
+	/// </summary>
+	void RetargetComposition( DelegateType& a_Old )
+	{
+		if ( !m_Composition )
+		{
+			return;
+		}
+
+		for ( size_t i = 0; i < m_Composition->Parents.size(); ++i )
+		{
+			StorageVector< DelegateType* >& Siblings = m_Composition->Parents[ i ]->m_Composition->Children;
+			std::replace( Siblings.begin(), Siblings.end(), &a_Old, this );
+		}
+
+		for ( size_t i = 0; i < m_Composition->Children.size(); ++i )
+		{
+			StorageVector< DelegateType* >& Parents = m_Composition->Children[ i ]->m_Composition->Parents;
+			std::replace( Parents.begin(), Parents.end(), &a_Old, this );
+		}
+
+		Invalidate();
+	}
+
+	/// <summary>
+	/// Rebuilds the flat arrays if the tree changed since they were built.
+	/// Returns false when they are stale but a pass over them is running.
+	/// </summary>
+	bool Flatten()
+	{
+		Composition& Tree = *m_Composition;
+
+		if ( Tree.FlatVersion == Tree.Version )
+		{
+			return true;
+		}
+
+		if ( Tree.Depth )
+		{
+			return false;
+		}
+
+		Tree.Invocations.clear();
+		Tree.Objects.clear();
+		Tree.Functions.clear();
+		Tree.Owners.clear();
+		Tree.Indices.clear();
+		Tree.Members.clear();
+
+		for ( size_t i = 0; i < Tree.Children.size(); ++i )
+		{
+			FlattenInto( Tree, *Tree.Children[ i ] );
+		}
+
+		// Grouping an Unordered member moved the version along while building, the arrays reflect that.
+		Tree.FlatVersion = Tree.Version;
+		return true;
+	}
+
+	static void FlattenInto( Composition& a_Tree, DelegateType& a_Member )
+	{
+		a_Member.Arrange();
+
+		if ( !IsFlattenable || a_Member.m_AffineCount || a_Member.m_FilterCount )
+		{
+			a_Tree.Invocations.push_back( nullptr );
+			a_Tree.Objects.push_back( nullptr );
+			a_Tree.Functions.push_back( nullptr );
+			a_Tree.Owners.push_back( &a_Member );
+			a_Tree.Indices.push_back( 0 );
+			return;
+		}
+
+		a_Tree.Members.push_back( &a_Member );
+		const size_t End = a_Member.GetDispatchEnd();
+
+		for ( size_t i = 0; i < End; ++i )
+		{
+			if ( a_Member.m_Invocations[ i ] )
+			{
+				a_Tree.Invocations.push_back( a_Member.m_Invocations[ i ] );
+				a_Tree.Objects.push_back( a_Member.m_Objects[ i ] );
+				a_Tree.Functions.push_back( a_Member.m_Functions[ i ] );
+				a_Tree.Owners.push_back( &a_Member );
+				a_Tree.Indices.push_back( static_cast< uint32_t >( i ) );
+			}
+		}
+
+		for ( size_t i = 0; a_Member.m_Composition && i < a_Member.m_Composition->Children.size(); ++i )
+		{
+			FlattenInto( a_Tree, *a_Member.m_Composition->Children[ i ] );
+		}
+	}
+
+	/// <summary>
+	/// Calls a_Call with every flattened subscriber below this delegate and
+	/// a_Nested with every attached delegate that dispatches itself, in
+	/// order, until either returns false. Once anything in the tree changes
+	/// mid pass, subscribers removed since are skipped. A nested broadcast
+	/// that finds the arrays stale cannot rebuild them under the running
+	/// pass, and has each attached delegate dispatch itself instead.
+	/// </summary>
+	template < typename Call, typename Nested >
+	bool VisitChildren( Call&& a_Call, Nested&& a_Nested )
+	{
+		Composition& Tree = *m_Composition;
+
+		if ( !Flatten() )
+		{
+			for ( size_t i = 0; i < Tree.Children.size(); ++i )
+			{
+				if ( !a_Nested( *Tree.Children[ i ] ) )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		CompositionScope Scope( Tree );
+		const uint64_t Version = Tree.Version;
+		const size_t Count = Tree.Invocations.size();
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			if ( const InvocationFunction Invocation = Tree.Invocations[ i ] )
+			{
+				if ( Tree.Version != Version && !Tree.Owners[ i ]->m_Invocations[ Tree.Indices[ i ] ] )
+				{
+					continue;
+				}
+
+				if ( !a_Call( Invocation, Tree.Objects[ i ], Tree.Functions[ i ] ) )
+				{
+					return false;
+				}
+			}
+			else if ( Tree.Owners[ i ] && !a_Nested( *Tree.Owners[ i ] ) )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template < typename T >
+	static void Permute( T& a_Values, const StorageVector< uint32_t >& a_Order )
+	{
+		T Result;
+		Result.reserve( a_Values.size() );
+
+		for ( size_t i = 0; i < a_Order.size(); ++i )
+		{
+			Result.push_back( a_Values[ a_Order[ i ] ] );
+		}
+
+		a_Values.swap( Result );
+	}
+
+	static void RemoveConnection( void* a_Delegate, DelegateHandle a_DelegateHandle )
+	{
+		static_cast< DelegateType* >( a_Delegate )->Remove( a_DelegateHandle );
+	}
+
+	inline ScopedConnection MakeConnection( DelegateHandle a_DelegateHandle )
+	{
+		return a_DelegateHandle.IsValid() ? ScopedConnection( this, &RemoveConnection, &m_Connections, a_DelegateHandle ) : ScopedConnection();
+	}
+
+	void DetachConnections()
+	{
+		while ( m_Connections )
+		{
+			m_Connections->Unlink();
+		}
+	}
+
+	void RetargetConnections()
+	{
+		for ( ScopedConnection* Current = m_Connections; Current; Current = Current->m_Next )
+		{
+			Current->m_Delegate = this;
+			Current->m_Head = &m_Connections;
+		}
+	}
+
+	void DestroyLambdas()
+	{
+		for ( size_t i = 0; i < m_Managers.size(); ++i )
+		{
+			if ( m_Affinities[ i ] )
+			{
+				m_Affinities[ i ]->IsConnected.store( false, std::memory_order_release );
+			}
+
+			ReleaseState( i );
+		}
+	}
+
+	/// <summary>
+	/// Destroys the subscriber's lambda state. A thread bound subscriber
+	/// hands it to its affinity instead, which retires through the
+	/// executor's next Pump.
+	/// </summary>
+	inline void ReleaseState( size_t a_Index )
+	{
+		if ( Affinity* Target = m_Affinities[ a_Index ] )
+		{
+			Target->Manager = m_Managers[ a_Index ];
+			Target->Executor->Post( Target );
+			m_Affinities[ a_Index ] = nullptr;
+		}
+		else if ( m_Managers[ a_Index ] )
+		{
+			m_Managers[ a_Index ]( LambdaOperation::Destroy, nullptr, InvokerType::GetOwned( m_Objects[ a_Index ], m_Functions[ a_Index ] ) );
+		}
+	}
+
+	template < class... T > friend auto MakeDelegate( T... );
+	template < class... > friend class DelegateRecorder;
+
+	StorageVector< InvocationFunction > m_Invocations;
+	StorageVector< void* >              m_Objects;
+	StorageVector< void* >              m_Functions;
+	StorageVector< LambdaManager >      m_Managers;
+	StorageVector< int32_t >            m_Priorities;
+	StorageVector< Affinity* >          m_Affinities;
+	StorageVector< uint64_t >           m_FilterKeys;
+	StorageVector< uint8_t >            m_IsFiltered;
+	StorageVector< uint32_t >           m_HandleIndices;
+	StorageVector< uint32_t >           m_Tombstones;
+	StorageVector< HandleSlot >         m_Handles;
+	StorageIndex< void* >               m_ByObject;
+	StorageIndex< void* >               m_ByFunction;
+	StorageIndex< InvocationFunction >  m_ByInvocation;
+	uint32_t                            m_FreeHandle;
+	size_t                              m_Holes;
+	size_t                              m_AffineCount;
+	size_t                              m_FilterCount;
+	KeyProjection                       m_Projection;
+	size_t                              m_StagedBegin;
+	uint32_t                            m_InvokeDepth;
+	DelegateOrdering                    m_Ordering;
+	size_t                              m_GroupedEnd;
+	ScopedConnection*                   m_Connections;
+	std::unique_ptr< Composition >      m_Composition;
+	EventRing< QueuedEvent >            m_Queue;
+	EventRing< QueuedEvent >            m_Flushing;
+	size_t                              m_QueueLimit;
+	std::vector< ParallelResult >       m_ParallelResults;
+
+#ifdef DELEGATE_HAS_COROUTINES
+	typename Awaiter::List              m_Waiters;
+#endif
+
+};
+
+//==========================================================================
+// Publish and subscribe keyed by event payload type. The event types are
+// fixed by the bus's template arguments, so an event's ID is its position
+// in that list and every Delegate sits in one flat tuple. Publish resolves
+// its delegate at compile time, with no hashing, lookup or RTTI.
+//==========================================================================
+template < typename... Events >
+class EventBus
+{
+public:
+
+	template < typename E >
+	using DelegateType = Delegate< void, const E& >;
+
+	template < typename E >
+	static constexpr size_t GetEventId()
+	{
+		static_assert( FunctionTraits::TypeIndex< E, Events... >::value < sizeof...( Events ), "The event type is not one of the bus's events." );
+		return FunctionTraits::TypeIndex< E, Events... >::value;
+	}
+
+	template < typename E >
+	inline DelegateType< E >& Get()
+	{
+		return std::get< GetEventId< E >() >( m_Delegates );
+	}
+
+	template < typename E >
+	inline const DelegateType< E >& Get() const
+	{
+		return std::get< GetEventId< E >() >( m_Delegates );
+	}
+
+	/// <summary>
+	/// Takes anything the event's Delegate::Add does, priority first
+	/// included.
+	/// </summary>
+	template < typename E, typename... Params >
+	inline DelegateHandle Subscribe( Params&&... a_Params )
+	{
+		return Get< E >().Add( std::forward< Params >( a_Params )... );
+	}
+
+	template < typename E >
+	inline bool Unsubscribe( DelegateHandle a_DelegateHandle )
+	{
+		return Get< E >().Remove( a_DelegateHandle );
+	}
+
+	template < typename E >
+	inline void Publish( const E& a_Event )
+	{
+		Get< E >().InvokeAll( a_Event );
+	}
+
+	template < typename E >
+	inline bool Enqueue( const E& a_Event )
+	{
+		return Get< E >().Enqueue( a_Event );
+	}
+
+	/// <summary>
+	/// Flushes every event type's queue in the order the types are listed
+	/// and returns how many events were dispatched.
+	/// </summary>
+	size_t Flush()
+	{
+		return Flush( std::index_sequence_for< Events... >() );
+	}
+
+	template < typename E >
+	inline size_t GetSubscriberCount() const
+	{
+		return Get< E >().GetCount();
+	}
+
+private:
+
+	template < size_t... Indices >
+	size_t Flush( std::index_sequence< Indices... > )
+	{
+		size_t Count = 0;
+		const size_t Counts[] = { 0, ( Count += std::get< Indices >( m_Delegates ).Flush() )... };
+		( void )Counts;
+		return Count;
+	}
+
+	std::tuple< DelegateType< Events >... > m_Delegates;
+
+};
+
+#ifndef DELEGATE_RECORDER_BUFFER_SIZE
+#define DELEGATE_RECORDER_BUFFER_SIZE 65536
+#endif
+
+//==========================================================================
+// Binary log of the broadcasts a Delegate saw. A 24 byte header is
+// followed by fixed size records: nanoseconds since the log was opened,
+// then every argument's bytes back to back. Logs are written and read in
+// the host's byte order and only replay into the same signature.
+//==========================================================================
+template < typename... Args >
+struct DelegateLogFormat
+{
+	static_assert( FunctionTraits::AllOf< std::is_trivially_copyable< std::decay_t< Args > >::value... >::value, "Only trivially copyable arguments can be recorded." );
+
+	struct Header
+	{
+		char     Magic[ 4 ];
+		uint32_t Version;
+		uint32_t ArgumentCount;
+		uint32_t RecordSize;
+		uint64_t Layout;
+	};
+
+	static constexpr size_t GetRecordSize()
+	{
+		const size_t Sizes[] = { 0, sizeof( std::decay_t< Args > )... };
+		size_t Result = sizeof( uint64_t );
+
+		for ( size_t Size : Sizes )
+		{
+			Result += Size;
+		}
+
+		return Result;
+	}
+
+	static constexpr size_t RecordSize = GetRecordSize();
+
+	/// <summary>
+	/// FNV-1a over the argument sizes, so a log is not replayed into a
+	/// delegate whose arguments it cannot fill.
+	/// </summary>
+	static uint64_t GetLayout()
+	{
+		const uint64_t Sizes[] = { sizeof...( Args ), static_cast< uint64_t >( sizeof( std::decay_t< Args > ) )... };
+		uint64_t Result = 14695981039346656037ull;
+
+		for ( uint64_t Size : Sizes )
+		{
+			Result = ( Result ^ Size ) * 1099511628211ull;
+		}
+
+		return Result;
+	}
+
+	static Header MakeHeader()
+	{
+		return Header{ { 'D', 'L', 'O', 'G' }, 1, static_cast< uint32_t >( sizeof...( Args ) ), static_cast< uint32_t >( RecordSize ), GetLayout() };
+	}
+
+	static bool IsCompatible( const uint8_t* a_Data, size_t a_Size )
+	{
+		if ( a_Size < sizeof( Header ) )
+		{
+			return false;
+		}
+
+		const Header Expected = MakeHeader();
+		Header Given;
+		memcpy( &Given, a_Data, sizeof( Header ) );
+
+		return memcmp( Given.Magic, Expected.Magic, sizeof( Expected.Magic ) ) == 0
+			&& Given.Version == Expected.Version
+			&& Given.ArgumentCount == Expected.ArgumentCount
+			&& Given.RecordSize == Expected.RecordSize
+			&& Given.Layout == Expected.Layout;
+	}
+
+	static void Pack( uint8_t* a_Record, uint64_t a_Timestamp, const std::decay_t< Args >&... a_Args )
+	{
+		memcpy( a_Record, &a_Timestamp, sizeof( a_Timestamp ) );
+		uint8_t* Cursor = a_Record + sizeof( a_Timestamp );
+		const int Packed[] = { 0, ( memcpy( Cursor, std::addressof( a_Args ), sizeof( a_Args ) ), Cursor += sizeof( a_Args ), 0 )... };
+		( void )Packed;
+	}
+
+	template < size_t... Indices >
+	static uint64_t Unpack( const uint8_t* a_Record, std::tuple< std::decay_t< Args >... >& a_Event, std::index_sequence< Indices... > )
+	{
+		uint64_t Timestamp;
+		memcpy( &Timestamp, a_Record, sizeof( Timestamp ) );
+		const uint8_t* Cursor = a_Record + sizeof( Timestamp );
+		const int Unpacked[] = { 0, ( memcpy( std::addressof( std::get< Indices >( a_Event ) ), Cursor, sizeof( std::get< Indices >( a_Event ) ) ), Cursor += sizeof( std::get< Indices >( a_Event ) ), 0 )... };
+		( void )Unpacked;
+		return Timestamp;
+	}
+};
+
+template < typename... Args >
+constexpr size_t DelegateLogFormat< Args... >::RecordSize;
+
+//==========================================================================
+// Appends every broadcast of an attached delegate to a binary log, for
+// DelegateReplayer to play back offline. Records collect in a buffer of
+// DELEGATE_RECORDER_BUFFER_SIZE bytes that is written out when full, on
+// Flush and on Close. A failed write closes the log.
+//==========================================================================
+template < typename... Args >
+class DelegateRecorder
+{
+public:
+
+	using Format = DelegateLogFormat< Args... >;
+
+	DelegateRecorder()
+		: m_File( nullptr )
+		, m_Buffer( Format::RecordSize > DELEGATE_RECORDER_BUFFER_SIZE ? Format::RecordSize : DELEGATE_RECORDER_BUFFER_SIZE )
+		, m_Used( 0 )
+		, m_Count( 0 )
+	{ }
+
+	explicit DelegateRecorder( const char* a_Path )
+		: DelegateRecorder()
+	{
+		Open( a_Path );
+	}
+
+	DelegateRecorder( const DelegateRecorder& ) = delete;
+	DelegateRecorder& operator=( const DelegateRecorder& ) = delete;
+
+	~DelegateRecorder()
+	{
+		Close();
+	}
+
+	/// <summary>
+	/// Starts a new log at a_Path, replacing any file there. Timestamps
+	/// count from here.
+	/// </summary>
+	bool Open( const char* a_Path )
+	{
+		Close();
+		m_File = fopen( a_Path, "wb" );
+
+		if ( !m_File )
+		{
+			return false;
+		}
+
+		const typename Format::Header Header = Format::MakeHeader();
+
+		if ( fwrite( &Header, sizeof( Header ), 1, m_File ) != 1 )
+		{
+			Close();
+			return false;
+		}
+
+		m_Start = std::chrono::steady_clock::now();
+		m_Count = 0;
+		return true;
+	}
+
+	void Close()
+	{
+		if ( m_File )
+		{
+			Flush();
+		}
+
+		if ( m_File )
+		{
+			fclose( m_File );
+			m_File = nullptr;
+		}
+
+		m_Used = 0;
+	}
+
+	/// <summary>
+	/// Writes the buffered records out, returns false if the log is closed
+	/// or the write failed.
+	/// </summary>
+	bool Flush()
+	{
+		if ( !m_File )
+		{
+			return false;
+		}
+
+		if ( m_Used && fwrite( m_Buffer.data(), 1, m_Used, m_File ) != m_Used )
+		{
+			fclose( m_File );
+			m_File = nullptr;
+			m_Used = 0;
+			return false;
+		}
+
+		m_Used = 0;
+		return fflush( m_File ) == 0;
+	}
+
+	inline bool IsOpen() const { return m_File != nullptr; }
+
+	/// <summary>
+	/// Number of records since Open, buffered ones included.
+	/// </summary>
+	inline size_t GetCount() const { return m_Count; }
+
+	/// <summary>
+	/// Appends one record. Does nothing while the log is closed.
+	/// </summary>
+	void Record( Args... a_Args )
+	{
+		if ( !m_File )
+		{
+			return;
+		}
+
+		if ( m_Used + Format::RecordSize > m_Buffer.size() && !Flush() )
+		{
+			return;
+		}
+
+		const uint64_t Timestamp = static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - m_Start ).count() );
+		Format::Pack( m_Buffer.data() + m_Used, Timestamp, a_Args... );
+		m_Used += Format::RecordSize;
+		++m_Count;
+	}
+
+	/// <summary>
+	/// Subscribes the recorder at the front of a_Delegate with the highest
+	/// priority, so it sees each broadcast's arguments before anyone can
+	/// change them. Subscribers added later by priority queue up behind
+	/// it; only a later Insert at the front, or the grouping of an
+	/// Unordered delegate, can move one ahead. Attached while invoking it
+	/// is staged like any addition and lands behind the other subscribers
+	/// of the highest priority. Enqueued events are recorded when they are
+	/// flushed. The connection must not outlive the recorder.
+	/// </summary>
+	inline ScopedConnection Attach( Delegate< void, Args... >& a_Delegate )
+	{
+		using InvokerType = typename Delegate< void, Args... >::InvokerType;
+
+		return a_Delegate.MakeConnection( a_Delegate.Emplace( 0, InvokerType( *this, &DelegateRecorder::Record ), INT32_MAX ) );
+	}
+
+private:
+
+	FILE*                                 m_File;
+	std::vector< uint8_t >                m_Buffer;
+	size_t                                m_Used;
+	size_t                                m_Count;
+	std::chrono::steady_clock::time_point m_Start;
+
+};
+
+//==========================================================================
+// Pace of DelegateReplayer::Play. Recorded reproduces the gaps between the
+// recorded broadcasts, Maximum dispatches them back to back.
+//==========================================================================
+enum class DelegateReplaySpeed
+{
+	Recorded,
+	Maximum
+};
+
+//==========================================================================
+// Plays a DelegateRecorder log back into a delegate of the same
+// signature. The log is memory mapped where the platform allows it and
+// read into memory otherwise. Arguments are copied out of each record
+// into one reused event, so records need no alignment.
+//==========================================================================
+template < typename... Args >
+class DelegateReplayer
+{
+public:
+
+	using Format      = DelegateLogFormat< Args... >;
+	using QueuedEvent = std::tuple< std::decay_t< Args >... >;
+
+	static_assert( std::is_default_constructible< QueuedEvent >::value, "Replayed arguments must be default constructible." );
+
+	DelegateReplayer()
+		: m_Data( nullptr )
+		, m_Size( 0 )
+		, m_Count( 0 )
+	{ }
+
+	explicit DelegateReplayer( const char* a_Path )
+		: DelegateReplayer()
+	{
+		Open( a_Path );
+	}
+
+	DelegateReplayer( const DelegateReplayer& ) = delete;
+	DelegateReplayer& operator=( const DelegateReplayer& ) = delete;
+
+	~DelegateReplayer()
+	{
+		Close();
+	}
+
+	/// <summary>
+	/// Returns false if a_Path cannot be read or was not recorded with
+	/// this signature. A record cut short at the end of the file is
+	/// ignored.
+	/// </summary>
+	bool Open( const char* a_Path )
+	{
+		Close();
+
+#ifdef DELEGATE_HAS_MMAP
+		const int Descriptor = ::open( a_Path, O_RDONLY );
+
+		if ( Descriptor < 0 )
+		{
+			return false;
+		}
+
+		struct stat Status;
+
+		if ( fstat( Descriptor, &Status ) == 0 && Status.st_size > 0 )
+		{
+			void* Mapping = mmap( nullptr, static_cast< size_t >( Status.st_size ), PROT_READ, MAP_PRIVATE, Descriptor, 0 );
+
+			if ( Mapping != MAP_FAILED )
+			{
+				madvise( Mapping, static_cast< size_t >( Status.st_size ), MADV_SEQUENTIAL );
+				m_Data = static_cast< const uint8_t* >( Mapping );
+				m_Size = static_cast< size_t >( Status.st_size );
+			}
+		}
+
+		::close( Descriptor );
+#else
+		if ( FILE* File = fopen( a_Path, "rb" ) )
+		{
+			uint8_t Block[ 4096 ];
+			size_t Read;
+
+			while ( ( Read = fread( Block, 1, sizeof( Block ), File ) ) > 0 )
+			{
+				m_Copy.insert( m_Copy.end(), Block, Block + Read );
+			}
+
+			fclose( File );
+			m_Data = m_Copy.data();
+			m_Size = m_Copy.size();
+		}
+#endif
+
+		if ( !m_Data || !Format::IsCompatible( m_Data, m_Size ) )
+		{
+			Close();
+			return false;
+		}
+
+		m_Count = ( m_Size - sizeof( typename Format::Header ) ) / Format::RecordSize;
+		return true;
+	}
+
+	void Close()
+	{
+#ifdef DELEGATE_HAS_MMAP
+		if ( m_Data )
+		{
+			munmap( const_cast< uint8_t* >( m_Data ), m_Size );
+		}
+#else
+		m_Copy = std::vector< uint8_t >();
+#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_Count = 0;
+	}
+
+	inline bool IsOpen() const { return m_Data != nullptr; }
+
+	inline size_t GetCount() const { return m_Count; }
+
+	/// <summary>
+	/// Time between the first and the last record.
+	/// </summary>
+	std::chrono::nanoseconds GetDuration() const
+	{
+		return m_Count ? std::chrono::nanoseconds( GetTimestamp( m_Count - 1 ) - GetTimestamp( 0 ) ) : std::chrono::nanoseconds( 0 );
+	}
+
+	/// <summary>
+	/// Broadcasts every record through a_Delegate's InvokeAll and returns
+	/// how many were played.
+	/// </summary>
+	template < typename Return >
+	size_t Play( Delegate< Return, Args... >& a_Delegate, DelegateReplaySpeed a_Speed = DelegateReplaySpeed::Maximum ) const
+	{
+		return Replay( a_Speed, [ & ]( QueuedEvent& a_Event )
+		{
+			InvokeAllUnpacked( a_Delegate, a_Event, std::index_sequence_for< Args... >() );
+		} );
+	}
+
+	/// <summary>
+	/// Calls the one subscriber behind a_DelegateHandle with every record.
+	/// </summary>
+	template < typename Return >
+	size_t Play( Delegate< Return, Args... >& a_Delegate, DelegateHandle a_DelegateHandle, DelegateReplaySpeed a_Speed = DelegateReplaySpeed::Maximum ) const
+	{
+		return Replay( a_Speed, [ & ]( QueuedEvent& a_Event )
+		{
+			InvokeUnpacked( a_Delegate, a_DelegateHandle, a_Event, std::index_sequence_for< Args... >() );
+		} );
+	}
+
+private:
+
+	inline const uint8_t* GetRecord( size_t a_Index ) const
+	{
+		return m_Data + sizeof( typename Format::Header ) + a_Index * Format::RecordSize;
+	}
+
+	inline uint64_t GetTimestamp( size_t a_Index ) const
+	{
+		uint64_t Timestamp;
+		memcpy( &Timestamp, GetRecord( a_Index ), sizeof( Timestamp ) );
+		return Timestamp;
+	}
+
+	/// <summary>
+	/// At Recorded speed each record waits until its offset from the first
+	/// one has passed since the replay began.
+	/// </summary>
+	template < typename Call >
+	size_t Replay( DelegateReplaySpeed a_Speed, Call&& a_Call ) const
+	{
+		const std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+		const uint64_t First = m_Count ? GetTimestamp( 0 ) : 0;
+		QueuedEvent Event;
+
+		for ( size_t i = 0; i < m_Count; ++i )
+		{
+			const uint64_t Timestamp = Format::Unpack( GetRecord( i ), Event, std::index_sequence_for< Args... >() );
+
+			if ( a_Speed == DelegateReplaySpeed::Recorded )
+			{
+				std::this_thread::sleep_until( Start + std::chrono::nanoseconds( Timestamp - First ) );
+			}
+
+			a_Call( Event );
+		}
+
+		return m_Count;
+	}
+
+	template < typename Return, size_t... Indices >
+	static inline void InvokeAllUnpacked( Delegate< Return, Args... >& a_Delegate, QueuedEvent& a_Event, std::index_sequence< Indices... > )
+	{
+		a_Delegate.InvokeAll( static_cast< Args&& >( std::get< Indices >( a_Event ) )... );
+	}
+
+	template < typename Return, size_t... Indices >
+	static inline void InvokeUnpacked( Delegate< Return, Args... >& a_Delegate, DelegateHandle a_DelegateHandle, QueuedEvent& a_Event, std::index_sequence< Indices... > )
+	{
+		a_Delegate.Invoke( a_DelegateHandle, static_cast< Args&& >( std::get< Indices >( a_Event ) )... );
+	}
+
+	const uint8_t*         m_Data;
+	size_t                 m_Size;
+	size_t                 m_Count;
+
+#ifndef DELEGATE_HAS_MMAP
+	std::vector< uint8_t > m_Copy;
+#endif
+
+};
+
+//==========================================================================
+// Flushes many CoalescingDelegates in one pass. A delegate lists itself
+// here when an Invoke first makes it dirty, so Flush walks only the
+// delegates that have something to dispatch, in the order they became
+// dirty. The registry must outlive the delegates that use it.
+//==========================================================================
+class CoalescingRegistry
+{
+public:
+
+	CoalescingRegistry()
+		: m_IsFlushing( false )
+	{ }
+
+	CoalescingRegistry( const CoalescingRegistry& ) = delete;
+	CoalescingRegistry& operator=( const CoalescingRegistry& ) = delete;
+
+	/// <summary>
+	/// Dispatches every dirty delegate once and returns how many did.
+	/// Delegates invoked by the subscribers during the pass are left for
+	/// the next Flush. Does nothing when called from within a Flush.
+	/// </summary>
+	size_t Flush()
+	{
+		if ( m_IsFlushing )
+		{
+			return 0;
+		}
+
+		m_IsFlushing = true;
+		m_Flushing.swap( m_Dirty );
+		size_t Count = 0;
+
+		for ( size_t i = 0; i < m_Flushing.size(); ++i )
+		{
+			if ( Entry* Current = m_Flushing[ i ] )
+			{
+				Current->IsListed = false;
+				Count += Current->FlushPending( Current ) ? 1 : 0;
+			}
+		}
+
+		m_Flushing.clear();
+		m_IsFlushing = false;
+		return Count;
+	}
+
+	/// <summary>
+	/// Number of delegates the next Flush will visit. Ones flushed on
+	/// their own since they were listed are still counted.
+	/// </summary>
+	inline size_t GetDirtyCount() const { return m_Dirty.size(); }
+
+private:
+
+	struct Entry
+	{
+		using FlushFunction = bool( * )( Entry* );
+
+		CoalescingRegistry* Registry;
+		FlushFunction       FlushPending;
+		bool                IsListed;
+	};
+
+	inline void List( Entry* a_Entry )
+	{
+		a_Entry->IsListed = true;
+		m_Dirty.push_back( a_Entry );
+	}
+
+	/// <summary>
+	/// Drops a destroyed delegate, including from a pass in progress.
+	/// </summary>
+	void Unlist( Entry* a_Entry )
+	{
+		const auto Found = std::find( m_Dirty.begin(), m_Dirty.end(), a_Entry );
+
+		if ( Found != m_Dirty.end() )
+		{
+			m_Dirty.erase( Found );
+		}
+
+		std::replace( m_Flushing.begin(), m_Flushing.end(), a_Entry, static_cast< Entry* >( nullptr ) );
+		a_Entry->IsListed = false;
+	}
+
+	std::vector< Entry* > m_Dirty;
+	std::vector< Entry* > m_Flushing;
+	bool                  m_IsFlushing;
+
+	template < typename... >
+	friend class CoalescingDelegate;
+
+};
+
+//==========================================================================
+// Delegate for events that fire many times per frame but only matter
+// once, such as "position changed". Invoke keeps the latest arguments, or
+// folds them into the pending ones through a reducer, and marks the
+// delegate dirty. Flush, or the registry's Flush, then broadcasts the
+// pending arguments once.
+//==========================================================================
+template < typename... Args >
+class CoalescingDelegate
+	: private CoalescingRegistry::Entry
+{
+public:
+
+	using DelegateType = Delegate< void, Args... >;
+	using QueuedEvent  = typename DelegateType::QueuedEvent;
+	using ReducerType  = Invoker< void, QueuedEvent&, Args... >;
+
+	CoalescingDelegate()
+		: Entry{ nullptr, &FlushEntry, false }
+		, m_IsDirty( false )
+	{ }
+
+	explicit CoalescingDelegate( CoalescingRegistry& a_Registry )
+		: Entry{ &a_Registry, &FlushEntry, false }
+		, m_IsDirty( false )
+	{ }
+
+	CoalescingDelegate( const CoalescingDelegate& ) = delete;
+	CoalescingDelegate& operator=( const CoalescingDelegate& ) = delete;
+
+	~CoalescingDelegate()
+	{
+		if ( IsListed )
+		{
+			Registry->Unlist( this );
+		}
+
+		Discard();
+	}
+
+	inline DelegateType& Get() { return m_Delegate; }
+	inline const DelegateType& Get() const { return m_Delegate; }
+
+	/// <summary>
+	/// Takes anything Delegate::Add does.
+	/// </summary>
+	template < typename... Params >
+	inline DelegateHandle Add( Params&&... a_Params )
+	{
+		return m_Delegate.Add( std::forward< Params >( a_Params )... );
+	}
+
+	template < typename... Params >
+	inline ScopedConnection Connect( Params&&... a_Params )
+	{
+		return m_Delegate.Connect( std::forward< Params >( a_Params )... );
+	}
+
+	inline bool Remove( DelegateHandle a_DelegateHandle )
+	{
+		return m_Delegate.Remove( a_DelegateHandle );
+	}
+
+	/// <summary>
+	/// Sets how an Invoke on a dirty delegate merges its arguments into
+	/// the pending ones. Without a reducer the latest arguments win.
+	/// </summary>
+	template < typename Reducer >
+	inline void SetReducer( Reducer a_Reducer )
+	{
+		m_Reducer = ReducerType( a_Reducer );
+	}
+
+	/// <summary>
+	/// Records the arguments for the next Flush instead of broadcasting.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	void Invoke( Params&&... a_Params )
+	{
+		if ( !m_IsDirty )
+		{
+			new ( &m_Pending ) QueuedEvent( std::forward< Params >( a_Params )... );
+			m_IsDirty = true;
+
+			if ( Registry && !IsListed )
+			{
+				Registry->List( this );
+			}
+		}
+		else if ( m_Reducer.IsSet() )
+		{
+			m_Reducer( Pending(), std::forward< Params >( a_Params )... );
+		}
+		else
+		{
+			Pending() = QueuedEvent( std::forward< Params >( a_Params )... );
+		}
+	}
+
+	/// <summary>
+	/// Broadcasts the pending arguments, returns false if there were none.
+	/// Invokes made by the subscribers are kept for the next Flush.
+	/// </summary>
+	bool Flush()
+	{
+		if ( !m_IsDirty )
+		{
+			return false;
+		}
+
+		QueuedEvent Event( std::move( Pending() ) );
+		Discard();
+		DispatchUnpacked( Event, std::index_sequence_for< Args... >() );
+		return true;
+	}
+
+	/// <summary>
+	/// Drops the pending arguments without broadcasting them.
+	/// </summary>
+	inline void Discard()
+	{
+		if ( m_IsDirty )
+		{
+			Pending().~QueuedEvent();
+			m_IsDirty = false;
+		}
+	}
+
+	inline bool IsDirty() const { return m_IsDirty; }
+
+	/// <summary>
+	/// Arguments the next Flush will broadcast. Only valid while dirty.
+	/// </summary>
+	inline const QueuedEvent& GetPending() const { return *reinterpret_cast< const QueuedEvent* >( &m_Pending ); }
+
+private:
+
+	using PendingStorage = typename std::aligned_storage< sizeof( QueuedEvent ), alignof( QueuedEvent ) >::type;
+
+	inline QueuedEvent& Pending() { return *reinterpret_cast< QueuedEvent* >( &m_Pending ); }
+
+	static bool FlushEntry( Entry* a_Entry )
+	{
+		return static_cast< CoalescingDelegate* >( a_Entry )->Flush();
+	}
+
+	template < size_t... Indices >
+	inline void DispatchUnpacked( QueuedEvent& a_Event, std::index_sequence< Indices... > )
+	{
+		m_Delegate.InvokeAll( static_cast< Args&& >( std::get< Indices >( a_Event ) )... );
+	}
+
+	DelegateType     m_Delegate;
+	ReducerType      m_Reducer;
+	PendingStorage   m_Pending;
+	bool             m_IsDirty;
+
+};
+
+#ifndef DELEGATE_MAX_READER_THREADS
+#define DELEGATE_MAX_READER_THREADS 128
+#endif
+
+//==========================================================================
+// Epoch based reclamation shared by every ConcurrentDelegate. Readers
+// announce the epoch they entered in a per thread slot, writers stamp a
+// retired snapshot with the epoch it was unpublished in and only free it
+// once every announced reader epoch is newer. A thread keeps its slot for
+// life, claiming one more than DELEGATE_MAX_READER_THREADS aborts.
+//==========================================================================
+class DelegateEpoch
+{
+public:
+
+	/// <summary>
+	/// Keeps the calling thread inside a read side critical section. Scopes
+	/// nest, only the outermost one announces and clears the epoch.
+	/// </summary>
+	class ReadScope
+	{
+	public:
+
+		ReadScope() { DelegateEpoch::Enter(); }
+		~ReadScope() { DelegateEpoch::Exit(); }
+
+		ReadScope( const ReadScope& ) = delete;
+		ReadScope& operator=( const ReadScope& ) = delete;
+
+	};
+
+	/// <summary>
+	/// Advances the global epoch and returns the epoch a snapshot that was
+	/// just unpublished should be retired with.
+	/// </summary>
+	static uint64_t Advance()
+	{
+		return GetEpoch().fetch_add( 1, std::memory_order_seq_cst );
+	}
+
+	/// <summary>
+	/// Oldest epoch announced by a reader that is currently inside a read
+	/// scope, or UINT64_MAX when no reader is.
+	/// </summary>
+	static uint64_t GetOldestReader()
+	{
+		uint64_t Oldest = ~uint64_t( 0 );
+		ReaderSlot* Slots = GetSlots();
+
+		for ( size_t i = 0; i < DELEGATE_MAX_READER_THREADS; ++i )
+		{
+			const uint64_t Epoch = Slots[ i ].Epoch.load( std::memory_order_seq_cst );
+
+			if ( Epoch != Quiescent && Epoch < Oldest )
+			{
+				Oldest = Epoch;
+			}
+		}
+
+		return Oldest;
+	}
+
+private:
+
+	static constexpr uint64_t Quiescent = 0;
+
+	struct alignas( 64 ) ReaderSlot
+	{
+		std::atomic< uint64_t > Epoch;
+		std::atomic< bool >     InUse;
+	};
+
+	struct ThreadState
+	{
+		ThreadState()
+			: Slot( Claim() )
+			, Depth( 0 )
+		{ }
+
+		~ThreadState()
+		{
+			Slot->InUse.store( false, std::memory_order_release );
+		}
+
+		ReaderSlot* Slot;
+		uint32_t    Depth;
+	};
+
+	static inline std::atomic< uint64_t >& GetEpoch()
+	{
+		static std::atomic< uint64_t > s_Epoch( 1 );
+		return s_Epoch;
+	}
+
+	static inline ReaderSlot* GetSlots()
+	{
+		static ReaderSlot s_Slots[ DELEGATE_MAX_READER_THREADS ] = { };
+		return s_Slots;
+	}
+
+	static inline ThreadState& GetThreadState()
+	{
+		thread_local ThreadState s_State;
+		return s_State;
+	}
+
+	static ReaderSlot* Claim()
+	{
+		ReaderSlot* Slots = GetSlots();
+
+		for ( size_t i = 0; i < DELEGATE_MAX_READER_THREADS; ++i )
+		{
+			bool Expected = false;
+
+			if ( !Slots[ i ].InUse.load( std::memory_order_relaxed ) &&
+				 Slots[ i ].InUse.compare_exchange_strong( Expected, true, std::memory_order_acquire ) )
+			{
+				return &Slots[ i ];
+			}
+		}
+
+		// More live reader threads than DELEGATE_MAX_READER_THREADS. Waiting
+		// for one to exit could hang forever, so fail loudly instead.
+		std::abort();
+	}
+
+	static inline void Enter()
+	{
+		ThreadState& State = GetThreadState();
+
+		if ( State.Depth++ == 0 )
+		{
+			// Sequentially consistent with Advance and GetOldestReader, so a
+			// writer either sees this announcement or the reader sees the
+			// snapshot published before the epoch it read.
+			State.Slot->Epoch.store( GetEpoch().load( std::memory_order_seq_cst ), std::memory_order_seq_cst );
+		}
+	}
+
+	static inline void Exit()
+	{
+		ThreadState& State = GetThreadState();
+
+		if ( --State.Depth == 0 )
+		{
+			State.Slot->Epoch.store( Quiescent, std::memory_order_release );
+		}
+	}
+
+};
+
+//==========================================================================
+// Delegate variant that can be invoked from any number of threads while
+// others subscribe and unsubscribe. Dispatch walks an immutable snapshot
+// of the invocation list without taking a lock. Writers serialise on a
+// mutex, publish a modified copy and leave the old snapshot to be freed
+// once the readers that could still see it have left.
+//==========================================================================
+template < typename Return = void, typename... Args >
+class ConcurrentDelegate
+{
+public:
+
+	using InvokerType        = Invoker< Return, Args... >;
+	using InvocationFunction = typename InvokerType::InvocationFunction;
+	using LambdaManager      = typename InvokerType::LambdaManager;
+	using QueuedEvent        = std::tuple< std::decay_t< Args >... >;
+
+	template < typename Object >
+	using MemberFunction = Return( Object::* )( Args... );
+	using StaticFunction = Return( * )( Args... );
+
+	/// <summary>
+	/// a_QueueCapacity bounds the events Enqueue can hold between flushes.
+	/// </summary>
+	ConcurrentDelegate( size_t a_QueueCapacity = DELEGATE_QUEUE_CAPACITY )
+		: m_Snapshot( new Snapshot() )
+		, m_FreeHandle( NoHandle )
+		, m_Queue( nullptr )
+		, m_QueueCapacity( a_QueueCapacity )
+		, m_IsFlushing( false )
+	{ }
+
+	ConcurrentDelegate( const ConcurrentDelegate& ) = delete;
+	ConcurrentDelegate& operator=( const ConcurrentDelegate& ) = delete;
+
+	~ConcurrentDelegate()
+	{
+		Snapshot* Current = m_Snapshot.load( std::memory_order_relaxed );
+
+		for ( size_t i = 0; i < Current->Managers.size(); ++i )
+		{
+			if ( Current->Managers[ i ] )
+			{
+				Current->Managers[ i ]( LambdaOperation::Destroy, nullptr, InvokerType::GetOwned( Current->Objects[ i ], Current->Functions[ i ] ) );
+			}
+		}
+
+		delete Current;
+
+		for ( size_t i = 0; i < m_Retired.size(); ++i )
+		{
+			Destroy( m_Retired[ i ] );
+		}
+
+		delete m_Queue.load( std::memory_order_relaxed );
+	}
+
+	inline size_t GetCount() const
+	{
+		DelegateEpoch::ReadScope Scope;
+		return m_Snapshot.load( std::memory_order_seq_cst )->Invocations.size();
+	}
+
+	/// <summary>
+	/// Subscribers removed while a broadcast is running on another thread
+	/// may still be invoked by that broadcast.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline void InvokeAll( Params&&... a_Params ) const
+	{
+		Broadcast( FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline void InvokeAll( std::vector< Return >& a_Output, Params&&... a_Params ) const
+	{
+		Broadcast( a_Output, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Returns true if a_Combiner stopped the broadcast early.
+	/// </summary>
+	template < typename Combiner, typename... Params, typename = FunctionTraits::EnableIfCombiner< Combiner, Return, std::tuple< Args... >, Params... > >
+	inline bool InvokeAll( Combiner&& a_Combiner, Params&&... a_Params ) const
+	{
+		return Combine( a_Combiner, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline Return Invoke( DelegateHandle a_DelegateHandle, Params&&... a_Params ) const
+	{
+		return InvokeAt( a_DelegateHandle, FunctionTraits::Forwarder< Args, Params >( std::forward< Params >( a_Params ) ).Get()... );
+	}
+
+	/// <summary>
+	/// Lock free, callable from any number of threads. Copies the arguments
+	/// into the bounded event queue and returns false if it is full.
+	/// </summary>
+	template < typename... Params, typename = FunctionTraits::EnableIfArguments< std::tuple< Args... >, Params... > >
+	inline bool Enqueue( Params&&... a_Params )
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		return GetQueue()->TryPush( std::forward< Params >( a_Params )... );
+	}
+
+	/// <summary>
+	/// Broadcasts the events queued so far oldest first against a single
+	/// snapshot and returns how many were dispatched. Only one thread
+	/// flushes at a time, a concurrent Flush returns 0.
+	/// </summary>
+	size_t Flush()
+	{
+		if ( m_IsFlushing.exchange( true, std::memory_order_acquire ) )
+		{
+			return 0;
+		}
+
+		MpscEventRing< QueuedEvent >* Queue = m_Queue.load( std::memory_order_acquire );
+		size_t Count = 0;
+
+		if ( Queue )
+		{
+			DelegateEpoch::ReadScope Scope;
+			const Snapshot* Current = m_Snapshot.load( std::memory_order_seq_cst );
+			const size_t Tail = Queue->GetTail();
+
+			for ( ; Queue->GetHead() != Tail; ++Count )
+			{
+				QueuedEvent* Event = Queue->Peek();
+
+				if ( !Event )
+				{
+					// Claimed by a producer that has not finished writing it.
+					break;
+				}
+
+				for ( size_t i = 0; i < Current->Invocations.size(); ++i )
+				{
+					InvokeUnpacked( *Current, i, *Event, std::index_sequence_for< Args... >() );
+				}
+
+				Queue->Pop();
+			}
+		}
+
+		m_IsFlushing.store( false, std::memory_order_release );
+		return Count;
+	}
+
+	inline DelegateHandle Add( const InvokerType& a_Invoker )
+	{
+		return Emplace( a_Invoker );
+	}
+
+	template < typename Lambda, typename = FunctionTraits::EnableIfLambdaF< Lambda > >
+	inline DelegateHandle Add( Lambda a_Lambda )
+	{
+		return Emplace( InvokerType( a_Lambda ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Add( Object* a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Emplace( InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	template < typename Object >
+	inline DelegateHandle Add( Object& a_Object, MemberFunction< Object > a_MemberFunction )
+	{
+		return Emplace( InvokerType( a_Object, a_MemberFunction ) );
+	}
+
+	inline DelegateHandle Add( StaticFunction a_StaticFunction )
+	{
+		return Emplace( InvokerType( a_StaticFunction ) );
+	}
+
+	bool Remove( DelegateHandle a_DelegateHandle )
+	{
+		std::lock_guard< std::mutex > Lock( m_WriteMutex );
+		const Snapshot* Current = m_Snapshot.load( std::memory_order_relaxed );
+		return Erase( Current->Find( a_DelegateHandle ) );
+	}
+
+	bool Remove( const InvokerType& a_Invoker )
+	{
+		std::lock_guard< std::mutex > Lock( m_WriteMutex );
+		const Snapshot* Current = m_Snapshot.load( std::memory_order_relaxed );
+
+		for ( size_t i = 0; i < Current->Invocations.size(); ++i )
+		{
+			if ( InvokerType::IsSame( a_Invoker, Current->Invocations[ i ], Current->Objects[ i ], Current->Functions[ i ], Current->Managers[ i ] ) )
+			{
+				return Erase( i );
+			}
+		}
+
+		return false;
+	}
+
+	void Clear()
+	{
+		std::lock_guard< std::mutex > Lock( m_WriteMutex );
+		Snapshot* Next = new Snapshot();
+		Snapshot* Current = m_Snapshot.load( std::memory_order_relaxed );
+
+		// Keep the slot table so handles from before the clear stay stale.
+		Next->Handles = Current->Handles;
+
+		for ( size_t i = 0; i < Current->Invocations.size(); ++i )
+		{
+			Next->Release( Current->HandleIndices[ i ], m_FreeHandle );
+
+			if ( Current->Managers[ i ] )
+			{
+				Current->Garbage.push_back( i );
+			}
+		}
+
+		Publish( Next );
+	}
+
+private:
+
+	void Broadcast( FunctionTraits::ForwardType< Args >... a_Args ) const
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		DelegateEpoch::ReadScope Scope;
+		const Snapshot* Current = m_Snapshot.load( std::memory_order_seq_cst );
+		const size_t Count = Current->Invocations.size();
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			Current->Invocations[ i ]( Current->Objects[ i ], Current->Functions[ i ], FunctionTraits::Pass< Args >( a_Args )... );
+		}
+	}
+
+	void Broadcast( std::vector< Return >& a_Output, FunctionTraits::ForwardType< Args >... a_Args ) const
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		DelegateEpoch::ReadScope Scope;
+		const Snapshot* Current = m_Snapshot.load( std::memory_order_seq_cst );
+		const size_t Count = Current->Invocations.size();
+		a_Output.reserve( a_Output.size() + Count );
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			a_Output.push_back( Current->Invocations[ i ]( Current->Objects[ i ], Current->Functions[ i ], FunctionTraits::Pass< Args >( a_Args )... ) );
+		}
+	}
+
+	template < typename Combiner >
+	bool Combine( Combiner& a_Combiner, FunctionTraits::ForwardType< Args >... a_Args ) const
+	{
+		static_assert( FunctionTraits::IsBroadcastable< Args... >::value, "Move only arguments can only be passed to a single target." );
+		DelegateEpoch::ReadScope Scope;
+		const Snapshot* Current = m_Snapshot.load( std::memory_order_seq_cst );
+		const size_t Count = Current->Invocations.size();
+
+		for ( size_t i = 0; i < Count; ++i )
+		{
+			if ( !a_Combiner( Current->Invocations[ i ]( Current->Objects[ i ], Current->Functions[ i ], FunctionTraits::Pass< Args >( a_Args )... ) ) )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	Return InvokeAt( DelegateHandle a_DelegateHandle, FunctionTraits::ForwardType< Args >... a_Args ) const
+	{
+		DelegateEpoch::ReadScope Scope;
+		const Snapshot* Current = m_Snapshot.load( std::memory_order_seq_cst );
+		const size_t Index = Current->Find( a_DelegateHandle );
+
+		if ( Index == NoIndex )
+		{
+			return Return();
+		}
+
+		return Current->Invocations[ Index ]( Current->Objects[ Index ], Current->Functions[ Index ], FunctionTraits::Pass< Args >( a_Args )... );
+	}
+
+	static constexpr uint32_t NoHandle = ~uint32_t( 0 );
+	static constexpr size_t   NoIndex  = ~size_t( 0 );
+
+	struct HandleSlot
+	{
+		uint32_t Index;
+		uint32_t Generation;
+	};
+
+	/// <summary>
+	/// Immutable once published. Lambda state is shared between snapshots
+	/// and destroyed together with the last snapshot that referenced it,
+	/// which lists the entry in Garbage.
+	/// </summary>
+	struct Snapshot
+	{
+		inline size_t Find( DelegateHandle a_DelegateHandle ) const
+		{
+			if ( a_DelegateHandle.m_Index >= Handles.size() )
+			{
+				return NoIndex;
+			}
+
+			const HandleSlot& Slot = Handles[ a_DelegateHandle.m_Index ];
+			return Slot.Generation == a_DelegateHandle.m_Generation ? Slot.Index : NoIndex;
+		}
+
+		inline void Release( uint32_t a_Slot, uint32_t& a_FreeHandle )
+		{
+			HandleSlot& Slot = Handles[ a_Slot ];
+
+			if ( ++Slot.Generation == 0 )
+			{
+				Slot.Generation = 1;
+			}
+
+			Slot.Index = a_FreeHandle;
+			a_FreeHandle = a_Slot;
+		}
+
+		std::vector< InvocationFunction > Invocations;
+		std::vector< void* >              Objects;
+		std::vector< void* >              Functions;
+		std::vector< LambdaManager >      Managers;
+		std::vector< uint32_t >           HandleIndices;
+		std::vector< HandleSlot >         Handles;
+		std::vector< size_t >             Garbage;
+		uint64_t                          RetireEpoch;
+	};
+
+	DelegateHandle Emplace( const InvokerType& a_Invoker )
+	{
+		if ( !a_Invoker.IsSet() )
+		{
+			return DelegateHandle();
+		}
+
+		std::lock_guard< std::mutex > Lock( m_WriteMutex );
+		Snapshot* Next = new Snapshot( *m_Snapshot.load( std::memory_order_relaxed ) );
+		uint32_t Slot = m_FreeHandle;
+
+		if ( Slot == NoHandle )
+		{
+			Slot = static_cast< uint32_t >( Next->Handles.size() );
+			Next->Handles.push_back( { 0, 1 } );
+		}
+		else
+		{
+			m_FreeHandle = Next->Handles[ Slot ].Index;
+		}
+
+		Next->Handles[ Slot ].Index = static_cast< uint32_t >( Next->Invocations.size() );
+		Next->Invocations.push_back( a_Invoker.m_Invocation );
+		void* Object = a_Invoker.m_Object;
+		void* Function = a_Invoker.m_Function;
+
+		if ( a_Invoker.m_Manager )
+		{
+			void*& Owned = Function ? Function : Object;
+			Owned = a_Invoker.m_Manager( LambdaOperation::Copy, nullptr, Owned );
+		}
+
+		Next->Objects.push_back( Object );
+		Next->Functions.push_back( Function );
+		Next->Managers.push_back( a_Invoker.m_Manager );
+		Next->HandleIndices.push_back( Slot );
+
+		const DelegateHandle Handle( Slot, Next->Handles[ Slot ].Generation );
+		Publish( Next );
+		return Handle;
+	}
+
+	bool Erase( size_t a_Index )
+	{
+		Snapshot* Current = m_Snapshot.load( std::memory_order_relaxed );
+
+		if ( a_Index >= Current->Invocations.size() )
+		{
+			return false;
+		}
+
+		Snapshot* Next = new Snapshot( *Current );
+		Next->Release( Next->HandleIndices[ a_Index ], m_FreeHandle );
+		Next->Invocations.erase( Next->Invocations.begin() + a_Index );
+		Next->Objects.erase( Next->Objects.begin() + a_Index );
+		Next->Functions.erase( Next->Functions.begin() + a_Index );
+		Next->Managers.erase( Next->Managers.begin() + a_Index );
+		Next->HandleIndices.erase( Next->HandleIndices.begin() + a_Index );
+
+		for ( size_t i = a_Index; i < Next->HandleIndices.size(); ++i )
+		{
+			Next->Handles[ Next->HandleIndices[ i ] ].Index = static_cast< uint32_t >( i );
+		}
+
+		if ( Current->Managers[ a_Index ] )
+		{
+			Current->Garbage.push_back( a_Index );
+		}
+
+		Publish( Next );
+		return true;
+	}
+
+	/// <summary>
+	/// Calls subscriber a_Index of a_Snapshot with a queued event's
+	/// arguments.
+	/// </summary>
+	template < typename Event, size_t... Indices >
+	static inline Return InvokeUnpacked( const Snapshot& a_Snapshot, size_t a_Index, Event& a_Event, std::index_sequence< Indices... > )
+	{
+		return a_Snapshot.Invocations[ a_Index ]( a_Snapshot.Objects[ a_Index ], a_Snapshot.Functions[ a_Index ], FunctionTraits::Pass< Args >( std::get< Indices >( a_Event ) )... );
+	}
+
+	/// <summary>
+	/// Created on first use, racing producers keep whichever ring wins.
+	/// </summary>
+	MpscEventRing< QueuedEvent >* GetQueue()
+	{
+		MpscEventRing< QueuedEvent >* Queue = m_Queue.load( std::memory_order_acquire );
+
+		if ( !Queue )
+		{
+			MpscEventRing< QueuedEvent >* Created = new MpscEventRing< QueuedEvent >( m_QueueCapacity );
+
+			if ( m_Queue.compare_exchange_strong( Queue, Created, std::memory_order_acq_rel, std::memory_order_acquire ) )
+			{
+				Queue = Created;
+			}
+			else
+			{
+				delete Created;
+			}
+		}
+
+		return Queue;
+	}
+
+	/// <summary>
+	/// Swaps in the next snapshot, retires the current one and frees every
+	/// retired snapshot no reader can still be walking.
+	/// </summary>
+	void Publish( Snapshot* a_Next )
+	{
+		Snapshot* Previous = m_Snapshot.exchange( a_Next, std::memory_order_seq_cst );
+		Previous->RetireEpoch = DelegateEpoch::Advance();
+		m_Retired.push_back( Previous );
+
+		const uint64_t Oldest = DelegateEpoch::GetOldestReader();
+		size_t Kept = 0;
+
+		for ( size_t i = 0; i < m_Retired.size(); ++i )
+		{
+			if ( m_Retired[ i ]->RetireEpoch < Oldest )
+			{
+				Destroy( m_Retired[ i ] );
+			}
+			else
+			{
+				m_Retired[ Kept++ ] = m_Retired[ i ];
+			}
+		}
+
+		m_Retired.resize( Kept );
+	}
+
+	static void Destroy( Snapshot* a_Snapshot )
+	{
+		for ( size_t i = 0; i < a_Snapshot->Garbage.size(); ++i )
+		{
+			const size_t Index = a_Snapshot->Garbage[ i ];
+			a_Snapshot->Managers[ Index ]( LambdaOperation::Destroy, nullptr, InvokerType::GetOwned( a_Snapshot->Objects[ Index ], a_Snapshot->Functions[ Index ] ) );
+		}
+
+		delete a_Snapshot;
+	}
+
+	std::atomic< Snapshot* > m_Snapshot;
+	std::mutex               m_WriteMutex;
+	std::vector< Snapshot* > m_Retired;
+	uint32_t                 m_FreeHandle;
+
+	std::atomic< MpscEventRing< QueuedEvent >* > m_Queue;
+	size_t                                       m_QueueCapacity;
+	std::atomic< bool >                          m_IsFlushing;
+
+};
@@ -0,0 +1,464 @@
+#include "Delegate.h"
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//==========================================================================
+// Behavioral tests
+//==========================================================================
+namespace Tests
+{
+	static size_t s_Failures = 0;
+
+	/// <summary>
+	/// Reports a failed check with its location and keeps going, so one run
+	/// lists every failure.
+	/// </summary>
+	inline void Check( bool a_Condition, const char* a_Expression, const char* a_File, int a_Line )
+	{
+		if ( !a_Condition )
+		{
+			cerr << a_File << ":" << a_Line << ": check failed: " << a_Expression << endl;
+			++s_Failures;
+		}
+	}
+
+#define CHECK( Expression ) Tests::Check( ( Expression ), #Expression, __FILE__, __LINE__ )
+
+	/// <summary>
+	/// Counts its live instances and poisons itself on destruction, so a
+	/// subscriber called after its captures were destroyed is noticed.
+	/// </summary>
+	struct Tracked
+	{
+		static constexpr uint32_t Alive = 0x600DF00D;
+		static constexpr uint32_t Dead  = 0xDEADBEEF;
+
+		Tracked()
+			: m_State( Alive )
+		{
+			s_Live.fetch_add( 1, memory_order_relaxed );
+		}
+
+		Tracked( const Tracked& a_Other )
+			: m_State( a_Other.m_State )
+		{
+			s_Live.fetch_add( 1, memory_order_relaxed );
+		}
+
+		~Tracked()
+		{
+			m_State = Dead;
+			s_Live.fetch_sub( 1, memory_order_relaxed );
+		}
+
+		inline bool IsAlive() const { return m_State == Alive; }
+
+		static atomic< long > s_Live;
+
+		volatile uint32_t m_State;
+	};
+
+	atomic< long > Tracked::s_Live( 0 );
+
+	//==========================================================================
+	// Handles
+	//==========================================================================
+	void HandleReuse()
+	{
+		Delegate< void, int > Subject;
+		int Calls = 0;
+
+		const DelegateHandle First = Subject.Add( [ & ]( int ) { ++Calls; } );
+		CHECK( First.IsValid() && Subject.IsValid( First ) );
+		CHECK( !DelegateHandle().IsValid() && !Subject.IsValid( DelegateHandle() ) );
+
+		// The freed slot is reused under a new generation, the stale handle stays dead.
+		CHECK( Subject.Remove( First ) );
+		const DelegateHandle Second = Subject.Add( [ & ]( int ) { Calls += 10; } );
+		CHECK( Second != First );
+		CHECK( !Subject.IsValid( First ) && Subject.IsValid( Second ) );
+		CHECK( !Subject.Remove( First ) );
+		CHECK( Subject.GetCount() == 1 );
+
+		Subject.InvokeAll( 0 );
+		CHECK( Calls == 10 );
+
+		// Handles survive the slots moving under them.
+		vector< DelegateHandle > Handles;
+
+		for ( int i = 0; i < 64; ++i )
+		{
+			Handles.push_back( Subject.Add( i % 3, [ &Calls, i ]( int ) { Calls += i; } ) );
+		}
+
+		for ( size_t i = 0; i < Handles.size(); i += 2 )
+		{
+			CHECK( Subject.Remove( Handles[ i ] ) );
+		}
+
+		Subject.InvokeAll( 0 );
+
+		for ( size_t i = 0; i < Handles.size(); ++i )
+		{
+			CHECK( Subject.IsValid( Handles[ i ] ) == ( i % 2 == 1 ) );
+
+			if ( i % 2 )
+			{
+				CHECK( Subject.GetPriority( Handles[ i ] ) == static_cast< int32_t >( i % 3 ) );
+			}
+		}
+
+		CHECK( Subject.Remove( Second ) );
+		CHECK( Subject.GetCount() == 32 );
+
+		Subject.Clear();
+		CHECK( !Subject.IsValid( Handles[ 1 ] ) );
+	}
+
+	void PriorityOrder()
+	{
+		Delegate< void, string& > Subject;
+
+		Subject.Add( 0, []( string& a_Log ) { a_Log += "c"; } );
+		Subject.Add( 2, []( string& a_Log ) { a_Log += "a"; } );
+		Subject.Add( 1, []( string& a_Log ) { a_Log += "b"; } );
+		Subject.Add( 2, []( string& a_Log ) { a_Log += "A"; } );
+		Subject.Add( []( string& a_Log ) { a_Log += "d"; } );
+
+		string Log;
+		Subject.InvokeAll( Log );
+		CHECK( Log == "aAbcd" );
+
+		// A positional insert is clamped between its neighbours' priorities.
+		Subject.Insert( 0, []( string& a_Log ) { a_Log += "0"; } );
+		Log.clear();
+		Subject.InvokeAll( Log );
+		CHECK( Log == "0aAbcd" );
+	}
+
+	//==========================================================================
+	// Changes made while dispatching
+	//==========================================================================
+	void RemoveWhileInvoking()
+	{
+		Delegate< void > Subject;
+		string Log;
+		DelegateHandle Later;
+		DelegateHandle Self;
+
+		Subject.Add( [ & ] { Log += "a"; Subject.Remove( Later ); } );
+		Self = Subject.Add( [ & ] { Log += "b"; Subject.Remove( Self ); } );
+		Later = Subject.Add( [ & ] { Log += "c"; } );
+		Subject.Add( [ & ] { Log += "d"; } );
+
+		Subject.InvokeAll();
+		CHECK( Log == "abd" );
+		CHECK( !Subject.IsValid( Later ) && !Subject.IsValid( Self ) );
+		CHECK( Subject.GetCount() == 2 );
+
+		Log.clear();
+		Subject.InvokeAll();
+		CHECK( Log == "ad" );
+
+		// Clearing from a subscriber keeps the running one's captures alive until it returns.
+		Delegate< void > Clearing;
+		bool IsAlive = false;
+		Tracked Witness;
+
+		Clearing.Add( [ &, Witness ] { Clearing.Clear(); IsAlive = Witness.IsAlive(); } );
+		Clearing.Add( [ & ] { Log += "x"; } );
+		Clearing.InvokeAll();
+		CHECK( IsAlive );
+		CHECK( Clearing.GetCount() == 0 );
+		CHECK( Log.find( 'x' ) == string::npos );
+	}
+
+	void AddWhileInvoking()
+	{
+		Delegate< void > Subject;
+		string Log;
+
+		Subject.Add( 1, [ & ]
+		{
+			Log += "a";
+
+			if ( Subject.GetCount() < 3 )
+			{
+				Subject.Add( 5, [ & ] { Log += "p"; } );
+				Subject.Add( [ & ] { Log += "n"; } );
+			}
+		} );
+
+		Subject.Add( [ & ] { Log += "b"; } );
+
+		// Added subscribers wait for the next dispatch and then keep their priority.
+		Subject.InvokeAll();
+		CHECK( Log == "ab" );
+
+		Log.clear();
+		Subject.InvokeAll();
+		CHECK( Log == "pabn" );
+
+		// A nested dispatch sees the same list and nothing it added.
+		Delegate< void, int > Nested;
+		int Depth = 0;
+		Log.clear();
+
+		Nested.Add( [ & ]( int a_Level )
+		{
+			Log += char( '0' + a_Level );
+
+			if ( a_Level == 0 )
+			{
+				Nested.Add( [ & ]( int ) { Log += "+"; } );
+				Nested.InvokeAll( 1 );
+			}
+
+			++Depth;
+		} );
+
+		Nested.InvokeAll( 0 );
+		CHECK( Log == "01" && Depth == 2 );
+		CHECK( Nested.GetCount() == 2 );
+	}
+
+	void DetachWhileInvoking()
+	{
+		Delegate< void > Root;
+		Delegate< void > Left;
+		Delegate< void > Right;
+		string Log;
+
+		CHECK( Root.Attach( Left ) && Root.Attach( Right ) );
+		CHECK( !Left.Attach( Root ) );
+
+		bool IsAttached = true;
+
+		Root.Add( [ & ] { Log += "r"; } );
+		Left.Add( [ & ] { Log += "l"; IsAttached = IsAttached && !Root.Detach( Right ); } );
+		Right.Add( [ & ] { Log += "R"; } );
+
+		// The pass under way skips the withdrawn child from then on.
+		Root.InvokeAll();
+		CHECK( Log == "rl" );
+		CHECK( !IsAttached );
+
+		Log.clear();
+		Root.InvokeAll();
+		CHECK( Log == "rl" );
+		CHECK( !Root.Detach( Right ) );
+
+		// A destroyed child is withdrawn from every delegate it was attached to.
+		Log.clear();
+		{
+			Delegate< void > Doomed;
+			Doomed.Add( [ & ] { Log += "d"; } );
+			CHECK( Right.Attach( Doomed ) && Root.Attach( Right ) );
+			Root.InvokeAll();
+			CHECK( Log == "rlRd" );
+		}
+
+		Log.clear();
+		Root.InvokeAll();
+		CHECK( Log == "rlR" );
+		CHECK( Right.GetChildCount() == 0 );
+	}
+
+	//==========================================================================
+	// Queued events
+	//==========================================================================
+	void FlushOrdering()
+	{
+		Delegate< void, int > Subject;
+		vector< int > Seen;
+
+		Subject.Add( [ & ]( int a_Value )
+		{
+			Seen.push_back( a_Value );
+
+			// Events queued by a subscriber wait for the next Flush, a nested one does nothing.
+			if ( a_Value == 1 )
+			{
+				Subject.Enqueue( 100 );
+				CHECK( Subject.Flush() == 0 );
+			}
+		} );
+
+		for ( int i = 0; i < 5; ++i )
+		{
+			CHECK( Subject.Enqueue( i ) );
+		}
+
+		CHECK( Subject.GetQueuedCount() == 5 );
+		CHECK( Subject.Flush() == 5 );
+		CHECK( ( Seen == vector< int >{ 0, 1, 2, 3, 4 } ) );
+		CHECK( Subject.GetQueuedCount() == 1 );
+
+		CHECK( Subject.Flush() == 1 );
+		CHECK( Seen.back() == 100 );
+		CHECK( Subject.Flush() == 0 );
+
+		Subject.SetQueueLimit( 2 );
+		CHECK( Subject.Enqueue( 7 ) && Subject.Enqueue( 8 ) && !Subject.Enqueue( 9 ) );
+		CHECK( Subject.Flush() == 2 );
+
+		// Every producer's events are flushed in the order it queued them.
+		const int Producers = 4;
+		const int Events = 2000;
+		ConcurrentDelegate< void, int, int > Concurrent( Producers * Events );
+		vector< int > Last( Producers, -1 );
+		bool IsOrdered = true;
+		int Count = 0;
+
+		Concurrent.Add( [ & ]( int a_Producer, int a_Value )
+		{
+			IsOrdered = IsOrdered && a_Value == Last[ a_Producer ] + 1;
+			Last[ a_Producer ] = a_Value;
+			++Count;
+		} );
+
+		vector< thread > Threads;
+
+		for ( int p = 0; p < Producers; ++p )
+		{
+			Threads.emplace_back( [ &Concurrent, p ]
+			{
+				for ( int i = 0; i < Events; ++i )
+				{
+					while ( !Concurrent.Enqueue( p, i ) )
+					{
+						this_thread::yield();
+					}
+				}
+			} );
+		}
+
+		for ( thread& Current : Threads )
+		{
+			Current.join();
+		}
+
+		while ( Concurrent.Flush() )
+		{
+		}
+
+		CHECK( IsOrdered );
+		CHECK( Count == Producers * Events );
+	}
+
+	//==========================================================================
+	// Snapshot retirement
+	//==========================================================================
+	void SnapshotRetirement()
+	{
+		const long LiveBefore = Tracked::s_Live.load();
+		{
+			ConcurrentDelegate< void, int& > Subject;
+			atomic< bool > IsRunning( true );
+			atomic< int > DeadCalls( 0 );
+			const Tracked Witness;
+
+			const auto MakeSubscriber = [ & ]
+			{
+				return [ Witness, &DeadCalls ]( int& a_Calls )
+				{
+					DeadCalls.fetch_add( Witness.IsAlive() ? 0 : 1, memory_order_relaxed );
+					++a_Calls;
+				};
+			};
+
+			for ( int i = 0; i < 8; ++i )
+			{
+				Subject.Add( MakeSubscriber() );
+			}
+
+			vector< thread > Readers;
+
+			for ( int r = 0; r < 3; ++r )
+			{
+				Readers.emplace_back( [ & ]
+				{
+					int Calls = 0;
+
+					while ( IsRunning.load( memory_order_relaxed ) )
+					{
+						Subject.InvokeAll( Calls );
+					}
+				} );
+			}
+
+			vector< thread > Writers;
+
+			for ( int w = 0; w < 2; ++w )
+			{
+				Writers.emplace_back( [ & ]
+				{
+					vector< DelegateHandle > Handles;
+
+					for ( int i = 0; i < 2000; ++i )
+					{
+						Handles.push_back( Subject.Add( MakeSubscriber() ) );
+
+						if ( Handles.size() > 4 )
+						{
+							Subject.Remove( Handles.front() );
+							Handles.erase( Handles.begin() );
+						}
+					}
+
+					for ( const DelegateHandle& Handle : Handles )
+					{
+						Subject.Remove( Handle );
+					}
+				} );
+			}
+
+			for ( thread& Current : Writers )
+			{
+				Current.join();
+			}
+
+			IsRunning = false;
+
+			for ( thread& Current : Readers )
+			{
+				Current.join();
+			}
+
+			CHECK( DeadCalls.load() == 0 );
+			CHECK( Subject.GetCount() == 8 );
+
+			// With no reader left, the next publish frees every retired snapshot.
+			Subject.Remove( Subject.Add( MakeSubscriber() ) );
+			CHECK( Tracked::s_Live.load() == LiveBefore + 1 + 8 );
+		}
+
+		CHECK( Tracked::s_Live.load() == LiveBefore );
+	}
+}
+
+int main()
+{
+	Tests::HandleReuse();
+	Tests::PriorityOrder();
+	Tests::RemoveWhileInvoking();
+	Tests::AddWhileInvoking();
+	Tests::DetachWhileInvoking();
+	Tests::FlushOrdering();
+	Tests::SnapshotRetirement();
+
+	if ( Tests::s_Failures )
+	{
+		cerr << Tests::s_Failures << " checks failed" << endl;
+		return 1;
+	}
+
+	cout << "All tests passed" << endl;
+	return 0;
+}